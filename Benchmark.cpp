@@ -0,0 +1,818 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#include <iostream>      // Include iostream header for printing results
+#include <iomanip>       // Include iomanip header for formatted columns
+#include <chrono>        // Include chrono header for timing
+#include <cmath>         // Include cmath header for std::log2
+#include <random>        // Include random header for generating input data
+#include <cstring>       // Include cstring header for command-line parsing
+#include <memory>        // Include memory header for std::allocator
+#include <string>        // Include string header for heavyweight elements
+#include "MyContainer.hpp"  // Include MyContainer header for container class
+#include "ConcurrentMyContainer.hpp"  // Include header for the thread-safe container
+#include "ShardedContainer.hpp"  // Include header for the sharded container
+#include <atomic>        // Include atomic header for stress-test counters
+#include <thread>        // Include thread header for reader and writer threads
+
+using namespace ariel;  // Use ariel namespace to access MyContainer
+
+using Clock = std::chrono::steady_clock;  // Monotonic clock used for all measurements
+
+volatile long long sink = 0;  // Sink for benchmark results so loops are not optimized away
+
+std::atomic<size_t> allocations{0};  // Allocations made through CountingAllocator
+
+/**
+ * @brief Standard allocator that counts allocations, to show which loops allocate per element.
+ */
+template<typename T>
+struct CountingAllocator {
+    typedef T value_type;  // Allocated type
+
+    CountingAllocator() = default;  // Stateless
+
+    template<typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}  // Rebinding copy
+
+    /**
+     * @param n Number of objects
+     * @return Uninitialized storage for n objects
+     * @throws std::bad_alloc If memory cannot be allocated
+     */
+    T* allocate(size_t n) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::allocator<T>().allocate(n);
+    }
+
+    /**
+     * @param p Storage returned by allocate
+     * @param n Number of objects
+     * @return None
+     * @throws None
+     */
+    void deallocate(T* p, size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const CountingAllocator<U>&) const {  // Stateless allocators are interchangeable
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const CountingAllocator<U>&) const {
+        return false;
+    }
+};
+
+typedef std::basic_string<char, std::char_traits<char>, CountingAllocator<char>> CountedString;  // std::string with counted allocations
+
+struct Record {       // Large element type for the dereference benchmark
+    int key;          // Sort key
+    char payload[252];  // Bulk that a by-value operator* would copy
+
+    bool operator<(const Record& other) const {  // Order by key
+        return key < other.key;
+    }
+
+    bool operator==(const Record& other) const {  // Equal keys
+        return key == other.key;
+    }
+};
+
+/**
+ * @param n Number of elements to generate
+ * @param seed Seed for the random generator
+ * @return Container holding n pseudo-random integers
+ * @throws None
+ */
+MyContainer<int> makeRandomContainer(size_t n, unsigned seed) {  // Build a container with random values
+    std::mt19937 gen(seed);  // Deterministic generator so runs are comparable
+    std::uniform_int_distribution<int> dist(0, 1000000);  // Value range
+    MyContainer<int> container;  // Container to fill
+    for (size_t i = 0; i < n; ++i) {
+        container.addElement(dist(gen));  // Append random value
+    }
+    return container;  // Return filled container
+}
+
+/**
+ * @param container Container to traverse
+ * @param begin Member function returning the begin iterator
+ * @param end Member function returning the end iterator
+ * @return Elapsed time in nanoseconds for one full traversal
+ * @throws None
+ */
+// Times the loop idiom used in Demo.cpp / Main.cpp, calling end_*() on every iteration
+template<typename It>
+double timeTraversal(const MyContainer<int>& container,
+                     It (MyContainer<int>::*begin)() const,
+                     It (MyContainer<int>::*end)() const) {
+    long long sum = 0;  // Accumulator so the loop is not optimized away
+    auto start = Clock::now();  // Start timer
+    for (auto it = (container.*begin)(); it != (container.*end)(); ++it) {
+        sum += *it;  // Touch every element
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    return std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+}
+
+/**
+ * @param name Label of the order being measured
+ * @param begin Member function returning the begin iterator
+ * @param end Member function returning the end iterator
+ * @return None
+ * @throws None
+ */
+// Prints ns/(n log n) for growing n; a flat column means the traversal is O(n log n)
+template<typename It>
+void benchmarkOrder(const char* name,
+                    It (MyContainer<int>::*begin)() const,
+                    It (MyContainer<int>::*end)() const) {
+    std::cout << name << std::endl;  // Print order label
+    for (size_t n = 1000; n <= 256000; n *= 4) {  // Grow the input geometrically
+        MyContainer<int> container = makeRandomContainer(n, 7);  // Build input
+        double ns = timeTraversal(container, begin, end);  // Measure one traversal
+        double nlogn = static_cast<double>(n) * std::log2(static_cast<double>(n));  // n log n reference
+        std::cout << "  n=" << std::setw(7) << n
+                  << "  total=" << std::setw(12) << std::fixed << std::setprecision(0) << ns << " ns"
+                  << "  ns/(n log n)=" << std::setprecision(3) << ns / nlogn << std::endl;  // Print row
+    }
+}
+
+/**
+ * @param name Label of the order being measured
+ * @param container Container to traverse, already sorted
+ * @param begin Member function returning the begin iterator
+ * @param end Member function returning the end iterator
+ * @return None
+ * @throws None
+ */
+// Best of several warm traversals with end_*() hoisted, so only operator* and operator++ are measured
+template<typename It>
+void benchmarkPerElement(const char* name, const MyContainer<int>& container,
+                         It (MyContainer<int>::*begin)() const,
+                         It (MyContainer<int>::*end)() const) {
+    double best = 0;  // Fastest traversal seen
+    for (int round = 0; round < 5; ++round) {
+        long long sum = 0;  // Accumulator so the loop is not optimized away
+        It last = (container.*end)();  // Built once, outside the timed loop
+        It it = (container.*begin)();  // Shares the cached permutation
+        auto start = Clock::now();  // Start timer
+        for (; it != last; ++it) {
+            sum += *it;  // Touch every element
+        }
+        auto stop = Clock::now();  // Stop timer
+        sink = sum;  // Keep the result observable
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    std::cout << "  " << std::setw(10) << std::left << name << std::right
+              << "  ns/element=" << std::fixed << std::setprecision(3) << best / static_cast<double>(container.size())
+              << std::endl;  // Print row
+}
+
+/**
+ * @return None
+ * @throws None
+ */
+// Compare the output of bench.out and bench_unchecked.out (make bench-unchecked) to see what the checks cost
+void benchmarkIterationChecks() {
+#ifdef ARIEL_UNCHECKED_ITERATORS
+    const char* mode = "unchecked";  // Built with -DARIEL_UNCHECKED_ITERATORS
+#else
+    const char* mode = "checked";  // Default build
+#endif
+    std::cout << "--- Per-element iteration cost, " << mode << " iterators, n=1000000 ---" << std::endl;
+    MyContainer<int> container = makeRandomContainer(1000000, 7);  // Build input
+    container.getSortedIndices();  // Sort outside the measurement
+    benchmarkPerElement<AscendingOrderIterator<int>>("Ascending", container, &MyContainer<int>::begin_ascending_order, &MyContainer<int>::end_ascending_order);
+    benchmarkPerElement<DescendingOrderIterator<int>>("Descending", container, &MyContainer<int>::begin_descending_order, &MyContainer<int>::end_descending_order);
+    benchmarkPerElement<SideCrossOrderIterator<int>>("SideCross", container, &MyContainer<int>::begin_side_cross_order, &MyContainer<int>::end_side_cross_order);
+    benchmarkPerElement("Reverse", container, &MyContainer<int>::begin_reverse_order, &MyContainer<int>::end_reverse_order);
+    benchmarkPerElement("Order", container, &MyContainer<int>::begin_order, &MyContainer<int>::end_order);
+    benchmarkPerElement("MiddleOut", container, &MyContainer<int>::begin_middle_out_order, &MyContainer<int>::end_middle_out_order);
+}
+
+/**
+ * @param name Label of the row
+ * @param begin Iterator to the first element
+ * @param end Iterator past the last element
+ * @param read Reads one element into a long long
+ * @return None
+ * @throws None
+ */
+// Same traversal twice: reading through the returned reference, then copying each element as a by-value operator* would
+template<typename It, typename Read>
+void benchmarkDereference(const char* name, It begin, It end, Read read) {
+    typedef typename std::decay<decltype(*begin)>::type Value;  // Element type
+    double ns[2];          // By reference, by copy
+    size_t allocated[2];   // Allocations during each traversal
+    size_t n = 0;          // Elements visited
+    for (int copy = 0; copy < 2; ++copy) {
+        long long sum = 0;  // Accumulator so the loop is not optimized away
+        n = 0;
+        size_t before = allocations.load();
+        auto start = Clock::now();  // Start timer
+        for (It it = begin; it != end; ++it, ++n) {
+            if (copy) {
+                Value value = *it;  // What T operator*() used to do
+                sum += read(value);
+            } else {
+                sum += read(*it);  // No copy
+            }
+        }
+        auto stop = Clock::now();  // Stop timer
+        allocated[copy] = allocations.load() - before;
+        sink = sum;  // Keep the result observable
+        ns[copy] = std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+    }
+    std::cout << "  " << std::setw(22) << std::left << name << std::right << std::fixed << std::setprecision(2)
+              << "  reference=" << std::setw(6) << ns[0] / n << " ns/element, "
+              << static_cast<double>(allocated[0]) / n << " allocs/element"
+              << "  copy=" << std::setw(6) << ns[1] / n << " ns/element, "
+              << static_cast<double>(allocated[1]) / n << " allocs/element" << std::endl;  // Print row
+}
+
+/**
+ * @return None
+ * @throws None
+ */
+// operator* returns const T&, so scanning heap-owning or large elements neither allocates nor copies
+void benchmarkHeavyElements() {
+    std::cout << "--- Heavyweight elements: operator* by reference vs a copy per element, n=200000 ---" << std::endl;
+    std::mt19937 gen(61);  // Deterministic generator
+    MyContainer<CountedString> strings;  // Every string is past the small-string buffer
+    MyContainer<Record> records;       // 256-byte elements
+    for (int i = 0; i < 200000; ++i) {
+        int key = static_cast<int>(gen() % 1000000);
+        std::string text = std::string(40, 'a') + std::to_string(key);
+        strings.addElement(CountedString(text.begin(), text.end()));
+        Record record = Record();
+        record.key = key;
+        records.addElement(record);
+    }
+    strings.getSortedIndices();  // Sort outside the measurement
+    records.getSortedIndices();
+    auto length = [](const CountedString& s) { return static_cast<long long>(s.size()); };
+    auto key = [](const Record& r) { return static_cast<long long>(r.key); };
+    benchmarkDereference("string insertion", strings.begin_order(), strings.end_order(), length);
+    benchmarkDereference("string ascending", strings.begin_ascending_order(), strings.end_ascending_order(), length);
+    benchmarkDereference("Record insertion", records.begin_order(), records.end_order(), key);
+    benchmarkDereference("Record ascending", records.begin_ascending_order(), records.end_ascending_order(), key);
+}
+
+/**
+ * @param n Number of elements in the container
+ * @param repeats Number of begin iterators to construct
+ * @return None
+ * @throws None
+ */
+// Read-heavy workload: many begin_*() calls between writes
+void benchmarkRepeatedBegin(size_t n, size_t repeats) {
+    MyContainer<int> container = makeRandomContainer(n, 11);  // Build input
+    long long sum = 0;  // Accumulator so the loop is not optimized away
+    auto start = Clock::now();  // Start timer
+    for (size_t r = 0; r < repeats; ++r) {
+        sum += *container.begin_ascending_order();  // Construct iterator and read first element
+        sum += *container.begin_descending_order();  // Same permutation; its descending form is built once
+        sum += *container.begin_side_cross_order();  // Same permutation in side-cross order
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+    std::cout << "  n=" << std::setw(7) << n << "  repeats=" << repeats
+              << "  ns/begin=" << std::setprecision(1) << ns / static_cast<double>(3 * repeats) << std::endl;  // Print row
+}
+
+struct BitReversedOrder {  // Generated order policy: positions visited in bit-reversed index order
+    /**
+     * @param data Values to order
+     * @return Every data index once, in bit-reversed order
+     * @throws None
+     */
+    static std::vector<size_t> generate(const std::vector<int>& data) {
+        size_t bits = 0;  // Bits needed to address every index
+        while ((static_cast<size_t>(1) << bits) < data.size()) {
+            ++bits;
+        }
+        std::vector<size_t> order;
+        order.reserve(data.size());
+        for (size_t i = 0; i < (static_cast<size_t>(1) << bits); ++i) {
+            size_t reversed = 0;
+            for (size_t b = 0; b < bits; ++b) {
+                reversed |= ((i >> b) & 1) << (bits - 1 - b);
+            }
+            if (reversed < data.size()) {
+                order.push_back(reversed);  // Skip indices past the end
+            }
+        }
+        return order;
+    }
+};
+
+/**
+ * @param n Number of elements in the container
+ * @param repeats Number of begin iterators to construct
+ * @return None
+ * @throws None
+ */
+// Custom orders share the per-version cache: only the first begin_custom_order() after a write generates
+void benchmarkCustomOrderBegin(size_t n, size_t repeats) {
+    MyContainer<int> container = makeRandomContainer(n, 11);  // Build input
+    long long sum = 0;  // Accumulator so the loop is not optimized away
+    auto start = Clock::now();  // Start timer
+    sum += *container.begin_custom_order<BitReversedOrder>();  // Generates the permutation
+    auto first = Clock::now();
+    for (size_t r = 0; r < repeats; ++r) {
+        sum += *container.begin_custom_order<BitReversedOrder>();  // Reuses it
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    std::cout << "  n=" << std::setw(7) << n << "  first begin=" << std::setprecision(1)
+              << std::chrono::duration<double, std::micro>(first - start).count() << " us"
+              << "  later ns/begin=" << std::chrono::duration<double, std::nano>(stop - first).count() / static_cast<double>(repeats)
+              << std::endl;  // Print row
+}
+
+std::atomic<size_t> projections{0};  // Calls made to DigitSumKey
+
+/**
+ * @brief Stateless, deliberately non-trivial projection: sum of decimal digits.
+ */
+struct DigitSumKey {
+    int operator()(int value) const {
+        ++projections;
+        int sum = 0;
+        for (value = value < 0 ? -value : value; value > 0; value /= 10) {
+            sum += value % 10;
+        }
+        return sum;
+    }
+};
+
+/**
+ * @param n Number of elements in the container
+ * @return None
+ * @throws None
+ */
+// Projected orders: keys computed once per element, versus a comparator that projects on every comparison
+void benchmarkProjectedSort(size_t n) {
+    MyContainer<int> container = makeRandomContainer(n, 12);  // Build input
+    DigitSumKey key;
+    long long sum = 0;  // Accumulator so the loop is not optimized away
+    projections = 0;
+    auto start = Clock::now();  // Start timer
+    sum += *container.begin_ascending_order(std::less<int>(), key);  // Projects n times, then sorts the keys
+    auto stop = Clock::now();  // Stop timer
+    size_t cached = projections.exchange(0);
+    double cachedUs = std::chrono::duration<double, std::micro>(stop - start).count();
+    auto naive = [key](int a, int b) { return key(a) < key(b); };  // Projects twice per comparison
+    start = Clock::now();
+    sum += *container.begin_ascending_order(naive);
+    stop = Clock::now();
+    size_t repeated = projections.exchange(0);
+    double naiveUs = std::chrono::duration<double, std::micro>(stop - start).count();
+    sink = sum;  // Keep the result observable
+    std::cout << "  n=" << std::setw(7) << n << std::setprecision(0)
+              << "  cached keys=" << std::setw(8) << cachedUs << " us (" << cached << " projections)"
+              << "  per comparison=" << std::setw(8) << naiveUs << " us (" << repeated << " projections)"
+              << std::endl;  // Print row
+}
+
+/**
+ * @param n Number of elements in the container
+ * @param k Number of leading elements to read
+ * @param mode Sort mode of the container
+ * @return Elapsed time in nanoseconds to build the order and read k elements
+ * @throws None
+ */
+// Consumers that stop early: build an ascending iterator and read only the first k elements
+double timeFirstK(size_t n, size_t k, SortMode mode) {
+    MyContainer<int> container = makeRandomContainer(n, 13);  // Build input
+    container.setSortMode(mode);  // Select eager or lazy sorting
+    long long sum = 0;  // Accumulator so the loop is not optimized away
+    auto start = Clock::now();  // Start timer
+    auto it = container.begin_ascending_order();  // Build order
+    for (size_t i = 0; i < k && i < n; ++i, ++it) {
+        sum += *it;  // Read one element
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    return std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+}
+
+/**
+ * @param n Initial number of elements
+ * @param batch Elements appended per round
+ * @param rounds Number of append-then-begin rounds
+ * @return None
+ * @throws None
+ */
+// Ingest loop: append a small batch, then request an ordered iterator
+void benchmarkAppendThenScan(size_t n, size_t batch, size_t rounds) {
+    MyContainer<int> container = makeRandomContainer(n, 17);  // Build input
+    std::mt19937 gen(19);  // Generator for appended values
+    std::uniform_int_distribution<int> dist(0, 1000000);  // Value range
+    long long sum = *container.begin_ascending_order();  // Build the initial permutation outside the timer
+    auto start = Clock::now();  // Start timer
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < batch; ++i) {
+            container.addElement(dist(gen));  // Append batch
+        }
+        sum += *container.begin_ascending_order();  // Merge batch into the cached order
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+    std::cout << "  n=" << std::setw(7) << n << "  batch=" << batch
+              << "  us/round=" << std::setprecision(1) << ns / 1000.0 / static_cast<double>(rounds) << std::endl;  // Print row
+}
+
+/**
+ * @param n Initial number of elements
+ * @param rounds Number of remove-then-begin rounds
+ * @return None
+ * @throws None
+ */
+// Mixed workload: remove one value, then request an ordered iterator
+void benchmarkRemoveThenScan(size_t n, size_t rounds) {
+    MyContainer<int> container = makeRandomContainer(n, 23);  // Build input
+    long long sum = *container.begin_ascending_order();  // Build the initial permutation outside the timer
+    auto start = Clock::now();  // Start timer
+    for (size_t r = 0; r < rounds; ++r) {
+        container.removeElement(container.getData()[r]);  // Remove a value known to be present
+        sum += *container.begin_ascending_order();  // Reuse the patched order
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = sum;  // Keep the result observable
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+    std::cout << "  n=" << std::setw(7) << n
+              << "  us/round=" << std::setprecision(1) << ns / 1000.0 / static_cast<double>(rounds) << std::endl;  // Print row
+}
+
+/**
+ * @param data Values to order
+ * @param radix True to use the radix backend, false for std::sort with IndexLess
+ * @return Elapsed time in nanoseconds to build the ascending permutation
+ * @throws None
+ */
+template<typename T>
+double timeIndexSort(const std::vector<T>& data, bool radix) {
+    std::vector<size_t> indices(data.size());  // Index vector
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = i;  // Initialize with 0, 1, 2, ...
+    }
+    auto start = Clock::now();  // Start timer
+    if (radix) {
+        radixSortIndices<T>(indices.begin(), indices.end(), data);  // LSD radix on (key, index) records
+    } else {
+        std::sort(indices.begin(), indices.end(), IndexLess<T>{data});  // Comparison sort on bare indices
+    }
+    auto stop = Clock::now();  // Stop timer
+    sink = static_cast<long long>(indices[0]);  // Keep the result observable
+    return std::chrono::duration<double, std::nano>(stop - start).count();  // Elapsed nanoseconds
+}
+
+/**
+ * @param name Label of the element type
+ * @param make Generator for one random value
+ * @return None
+ * @throws None
+ */
+// Compares the comparison sort and the radix backend for growing n
+template<typename T, typename Gen>
+void benchmarkSortBackends(const char* name, Gen make) {
+    std::cout << name << std::endl;  // Print type label
+    std::mt19937 gen(29);  // Deterministic generator
+    for (size_t n = 10000; n <= 4000000; n *= 20) {  // Grow the input geometrically
+        std::vector<T> data(n);  // Input values
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = make(gen);  // Random value
+        }
+        double cmp = timeIndexSort(data, false);  // Comparison sort
+        double rdx = timeIndexSort(data, true);   // Radix sort
+        std::cout << "  n=" << std::setw(8) << n
+                  << "  std::sort=" << std::setw(9) << std::setprecision(0) << cmp / 1000.0 << " us"
+                  << "  radix=" << std::setw(9) << rdx / 1000.0 << " us"
+                  << "  speedup=" << std::setprecision(2) << cmp / rdx << "x" << std::endl;  // Print row
+    }
+}
+
+// 12-byte plain struct ordered by one field, standing in for struct-valued containers
+struct Sample {
+    int key;       // Field used for ordering
+    float weight;  // Payload
+    int id;        // Payload
+    bool operator<(const Sample& other) const { return key < other.key; }  // Orders by key only
+};
+
+/**
+ * @param name Label of the element type
+ * @param make Generator for one random value
+ * @return None
+ * @throws None
+ */
+// Comparison sort on bare indices vs on contiguous (key, index) records, from L1-resident to beyond LLC
+template<typename T, typename Gen>
+void benchmarkRecordSort(const char* name, Gen make) {
+    std::cout << name << std::endl;  // Print type label
+    std::mt19937 gen(37);  // Deterministic generator
+    for (size_t n = 1000; n <= 8192000; n *= 8) {  // 1K (L1) .. 8M (well beyond LLC)
+        std::vector<T> data(n);  // Input values
+        for (size_t i = 0; i < n; ++i) {
+            data[i] = make(gen);  // Random value
+        }
+        std::vector<size_t> a(n), b(n);  // Index vectors
+        for (size_t i = 0; i < n; ++i) a[i] = b[i] = i;  // Initialize with 0, 1, 2, ...
+        auto t0 = Clock::now();
+        std::sort(a.begin(), a.end(), IndexLess<T>{data});  // Two random loads per comparison
+        auto t1 = Clock::now();
+        recordSortIndices<T>(b.begin(), b.end(), data);  // Keys next to indices
+        auto t2 = Clock::now();
+        sink = static_cast<long long>(a[0] + b[0]);  // Keep the results observable
+        double idx = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(n);  // ns per element
+        double rec = std::chrono::duration<double, std::nano>(t2 - t1).count() / static_cast<double>(n);  // ns per element
+        std::cout << "  n=" << std::setw(8) << n << std::setprecision(1)
+                  << "  indices=" << std::setw(6) << idx << " ns/elem"
+                  << "  records=" << std::setw(6) << rec << " ns/elem"
+                  << "  speedup=" << std::setprecision(2) << idx / rec << "x" << std::endl;  // Print row
+    }
+}
+
+/**
+ * @param argc Number of command-line arguments
+ * @param argv Command-line arguments; "iteration" runs only the per-element iteration section
+ * @return 0 on successful execution
+ * @throws None
+ */
+int main(int argc, char* argv[]) {  // Benchmark entry point
+    if (argc > 1 && std::strcmp(argv[1], "iteration") == 0) {
+        benchmarkIterationChecks();  // Quick comparison between checked and unchecked builds
+        benchmarkHeavyElements();
+        return 0;
+    }
+
+    std::cout << "--- Full traversal cost (loop idiom with end_*() per iteration) ---" << std::endl;
+    benchmarkOrder<AscendingOrderIterator<int>>("Ascending", &MyContainer<int>::begin_ascending_order, &MyContainer<int>::end_ascending_order);
+    benchmarkOrder<DescendingOrderIterator<int>>("Descending", &MyContainer<int>::begin_descending_order, &MyContainer<int>::end_descending_order);
+    benchmarkOrder<SideCrossOrderIterator<int>>("SideCross", &MyContainer<int>::begin_side_cross_order, &MyContainer<int>::end_side_cross_order);
+    benchmarkOrder("Reverse", &MyContainer<int>::begin_reverse_order, &MyContainer<int>::end_reverse_order);
+    benchmarkOrder("Order", &MyContainer<int>::begin_order, &MyContainer<int>::end_order);
+    benchmarkOrder("MiddleOut", &MyContainer<int>::begin_middle_out_order, &MyContainer<int>::end_middle_out_order);
+
+    benchmarkIterationChecks();
+    benchmarkHeavyElements();
+
+    std::cout << "--- Repeated begin_*() on an unchanged container ---" << std::endl;
+    benchmarkRepeatedBegin(100000, 1000);  // First call sorts, the rest reuse the cache
+
+    std::cout << "--- Repeated begin_custom_order() with a generated (bit-reversed) order ---" << std::endl;
+    benchmarkCustomOrderBegin(100000, 1000);  // First call generates, the rest reuse the cache
+
+    std::cout << "--- begin_ascending_order(comp, proj): projected keys vs projecting in the comparator ---" << std::endl;
+    benchmarkProjectedSort(1000000);
+
+    std::cout << "--- Reading the first k of n elements in ascending order (eager vs lazy) ---" << std::endl;
+    for (size_t k : {32, 1000, 10000, 1000000}) {  // Small prefixes grow the cost by k log k only; then a full traversal
+        double eager = timeFirstK(1000000, k, SortMode::Eager);  // Full sort up front
+        double lazy = timeFirstK(1000000, k, SortMode::Lazy);  // Sort on demand
+        std::cout << "  n=1000000  k=" << std::setw(7) << k
+                  << "  eager=" << std::setw(10) << std::setprecision(0) << eager / 1000.0 << " us"
+                  << "  lazy=" << std::setw(10) << lazy / 1000.0 << " us" << std::endl;  // Print row
+    }
+
+    std::cout << "--- Append a batch, then begin_ascending_order() ---" << std::endl;
+    benchmarkAppendThenScan(1000000, 100, 20);  // Merge cost is linear in n, not n log n
+
+    std::cout << "--- removeElement, then begin_ascending_order() ---" << std::endl;
+    benchmarkRemoveThenScan(1000000, 20);  // Patch cost is linear in n, not n log n
+
+    std::cout << "--- Narrow key ranges: comparison sort vs counting sort fast path ---" << std::endl;
+    for (size_t n : {1000, 100000, 1000000}) {
+        std::mt19937 gen(31);  // Deterministic generator
+        std::vector<char> chars(n);  // char container payload
+        std::vector<int> narrow(n);  // Integers in [0, 1000)
+        for (size_t i = 0; i < n; ++i) {
+            chars[i] = static_cast<char>('a' + gen() % 26);  // Lowercase letters
+            narrow[i] = static_cast<int>(gen() % 1000);  // Narrow integer range
+        }
+        std::vector<size_t> a(n), b(n), c(n), d(n);  // Index vectors
+        for (size_t i = 0; i < n; ++i) a[i] = b[i] = c[i] = d[i] = i;  // Initialize with 0, 1, 2, ...
+        auto t0 = Clock::now();
+        std::sort(a.begin(), a.end(), IndexLess<char>{chars});  // Comparison sort on chars
+        auto t1 = Clock::now();
+        countingSortIndices<char>(b.begin(), b.end(), chars);  // Counting sort on chars
+        auto t2 = Clock::now();
+        std::sort(c.begin(), c.end(), IndexLess<int>{narrow});  // Comparison sort on narrow ints
+        auto t3 = Clock::now();
+        countingSortIndices<int>(d.begin(), d.end(), narrow);  // Counting sort on narrow ints
+        auto t4 = Clock::now();
+        sink = static_cast<long long>(a[0] + b[0] + c[0] + d[0]);  // Keep the results observable
+        auto us = [](Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); };  // To microseconds
+        std::cout << "  n=" << std::setw(8) << n << std::setprecision(0)
+                  << "  char: std::sort=" << std::setw(7) << us(t1 - t0) << " us counting=" << std::setw(6) << us(t2 - t1) << " us"
+                  << "  int[0,1000): std::sort=" << std::setw(7) << us(t3 - t2) << " us counting=" << std::setw(6) << us(t4 - t3) << " us"
+                  << std::endl;  // Print row
+    }
+
+    std::cout << "--- Ascending permutation: comparison sort vs radix backend ---" << std::endl;
+    benchmarkSortBackends<int>("int", [](std::mt19937& g) { return static_cast<int>(g()); });
+    benchmarkSortBackends<double>("double", [](std::mt19937& g) { return std::uniform_real_distribution<double>(-1e6, 1e6)(g); });
+
+    std::cout << "--- Comparison sort: bare indices vs (key, index) records ---" << std::endl;
+    benchmarkRecordSort<int>("int", [](std::mt19937& g) { return static_cast<int>(g()); });
+    benchmarkRecordSort<Sample>("Sample (12-byte struct)", [](std::mt19937& g) {
+        return Sample{static_cast<int>(g()), 1.0f, 0};  // Random key, fixed payload
+    });
+
+    std::cout << "--- Parallel index sort (hardware threads: " << std::thread::hardware_concurrency() << ") ---" << std::endl;
+    {
+        std::mt19937 gen(41);  // Deterministic generator
+        std::vector<double> data(4000000);  // Large input
+        for (double& v : data) {
+            v = std::uniform_real_distribution<double>(-1e6, 1e6)(gen);  // Random value
+        }
+        ParallelSortConfig saved = parallelSortConfig();  // Remembers global tuning
+        for (size_t threads : {1, 2, 4, 8}) {
+            parallelSortConfig().threads = threads;  // Chunks sorted concurrently
+            std::vector<size_t> indices(data.size());  // Index vector
+            for (size_t i = 0; i < indices.size(); ++i) indices[i] = i;  // Initialize with 0, 1, 2, ...
+            auto start = Clock::now();
+            sortIndices<double>(indices.begin(), indices.end(), data);  // Dispatching entry point
+            auto stop = Clock::now();
+            sink = static_cast<long long>(indices[0]);  // Keep the result observable
+            std::cout << "  n=4000000 double  threads=" << threads << "  "
+                      << std::setprecision(0) << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;  // Print row
+        }
+        parallelSortConfig() = saved;  // Restores global tuning
+    }
+
+    std::cout << "--- Heavy per-element work: serial iterator vs parallel_transform_reduce ---" << std::endl;
+    {
+        MyContainer<int> container = makeRandomContainer(200000, 43);  // Input
+        auto heavy = [](int x) {  // Roughly a microsecond of arithmetic per element
+            double v = x;
+            for (int k = 0; k < 200; ++k) {
+                v = std::sqrt(v + k);
+            }
+            return static_cast<long long>(v);
+        };
+        container.getSortedIndices();  // Build the permutation outside the timings
+        auto start = Clock::now();
+        long long serial = 0;
+        for (auto it = container.begin_middle_out_order(); it != container.end_middle_out_order(); ++it) {
+            serial += heavy(*it);  // One element at a time
+        }
+        auto mid = Clock::now();
+        long long parallel = container.parallel_transform_reduce(Order::MiddleOut, 0LL, std::plus<long long>(), heavy);  // Chunks on the scheduler
+        auto stop = Clock::now();
+        sink = serial + parallel;  // Keep the results observable
+        std::cout << "  n=200000 middle-out  workers=" << TaskScheduler::global().size() << "  serial "
+                  << std::setprecision(0) << std::chrono::duration<double, std::milli>(mid - start).count() << " ms  parallel "
+                  << std::chrono::duration<double, std::milli>(stop - mid).count() << " ms" << std::endl;  // Print row
+    }
+
+    std::cout << "--- Scan with interleaved appends: checked (retry) vs snapshot ---" << std::endl;
+    for (IterationMode mode : {IterationMode::Checked, IterationMode::Snapshot}) {
+        MyContainer<int> container = makeRandomContainer(100000, 47);  // Input
+        container.setIterationMode(mode);
+        size_t retries = 0;  // Scans restarted after a write
+        auto start = Clock::now();
+        bool finished = false;
+        while (!finished) {
+            try {
+                long long total = 0;
+                size_t read = 0;
+                for (auto it = container.begin_ascending_order(); it != container.end_ascending_order(); ++it) {
+                    total += *it;
+                    if (++read % 1000 == 0 && retries < 20) {
+                        container.addElement(static_cast<int>(read));  // Writer appends mid-scan (bounded so checked mode ends)
+                    }
+                }
+                sink = total;
+                finished = true;
+            } catch (const std::runtime_error&) {
+                ++retries;  // Checked mode: start over
+            }
+        }
+        auto stop = Clock::now();
+        std::cout << "  " << (mode == IterationMode::Checked ? "checked " : "snapshot") << "  retries=" << retries << "  "
+                  << std::setprecision(1) << std::chrono::duration<double, std::milli>(stop - start).count() << " ms" << std::endl;  // Print row
+    }
+
+    std::cout << "--- ConcurrentMyContainer stress: 4 readers, one writer at growing rates ---" << std::endl;
+    for (long writesPerSecond : {0L, 1000L, 10000L, 100000L, -1L}) {  // -1 writes as fast as possible
+        ConcurrentMyContainer<int> container;  // Shared container
+        std::mt19937 gen(53);  // Deterministic generator
+        for (int i = 0; i < 100000; ++i) {
+            container.addElement(static_cast<int>(gen() % 1000000));  // Initial contents
+        }
+        std::atomic<bool> done(false);  // Stops every thread
+        std::atomic<long long> scans(0);  // Reader scans of the 64 smallest elements
+        std::atomic<long long> writes(0);  // Writer appends
+        std::vector<long long> totals(4, 0);  // One result per reader; sink is written once, after join()
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&, r] {
+                long long total = 0;
+                while (!done.load()) {
+                    auto it = container.begin_ascending_order();  // Shares the sorted permutation
+                    for (int k = 0; k < 64; ++k, ++it) {
+                        total += *it;  // Reads from a pinned snapshot
+                    }
+                    scans.fetch_add(1);
+                }
+                totals[r] = total;  // Only this reader writes its slot
+            });
+        }
+        std::thread writer([&] {
+            auto start = Clock::now();
+            while (!done.load()) {
+                if (writesPerSecond >= 0) {
+                    auto due = start + std::chrono::microseconds(writesPerSecond ? writes.load() * 1000000 / writesPerSecond : 1000000000LL);
+                    if (Clock::now() < due) {
+                        std::this_thread::yield();  // Not time for the next write yet
+                        continue;
+                    }
+                }
+                container.addElement(static_cast<int>(writes.load() % 1000000));  // Serialized append
+                writes.fetch_add(1);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));  // Measurement window
+        done = true;
+        writer.join();
+        long long total = 0;
+        for (int r = 0; r < 4; ++r) {
+            readers[r].join();
+            total += totals[r];
+        }
+        sink = total;  // Keep the results observable
+        std::cout << "  writer rate=" << std::setw(7) << (writesPerSecond < 0 ? std::string("max") : std::to_string(writesPerSecond))
+                  << "/s  writes=" << std::setw(8) << writes.load()
+                  << "  reader scans/s=" << std::setw(10) << std::setprecision(0) << scans.load() / 0.5 << std::endl;  // Print row
+    }
+
+    std::cout << "--- Multi-producer appends: locked addElement vs buffered shards ---" << std::endl;
+    for (int producers : {1, 2, 4, 8}) {
+        double ms[2];  // Locked, buffered
+        for (int buffered = 0; buffered < 2; ++buffered) {
+            ConcurrentMyContainer<int> container;  // Shared container
+            auto start = Clock::now();
+            std::vector<std::thread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&container, buffered] {
+                    for (int i = 0; i < 200000; ++i) {
+                        if (buffered) {
+                            container.addElementBuffered(i);  // Own shard
+                        } else {
+                            container.addElement(i);  // Container lock
+                        }
+                    }
+                });
+            }
+            for (std::thread& t : threads) {
+                t.join();
+            }
+            container.flush();  // Publish everything
+            auto stop = Clock::now();
+            sink = static_cast<long long>(container.size());
+            ms[buffered] = std::chrono::duration<double, std::milli>(stop - start).count();
+        }
+        std::cout << "  producers=" << producers << "  x200000  locked=" << std::setprecision(1) << ms[0]
+                  << " ms  buffered+flush=" << ms[1] << " ms" << std::endl;  // Print row
+    }
+
+    std::cout << "--- Single MyContainer vs ShardedContainer: first sorted scan ---" << std::endl;
+    for (size_t shardCount : {1, 4, 16}) {
+        std::mt19937 gen(59);  // Same input for every row
+        MyContainer<int> single;
+        ShardedContainer<int> sharded(shardCount);
+        for (int i = 0; i < 2000000; ++i) {
+            int v = static_cast<int>(gen() % 100000000);  // Wide range, no counting sort
+            single.addElement(v);
+            sharded.addElement(v);
+        }
+        auto start = Clock::now();
+        long long total = 0;
+        for (auto it = single.begin_ascending_order(); it != single.end_ascending_order(); ++it) {
+            total += *it;  // Global sort, then linear scan
+        }
+        auto mid = Clock::now();
+        for (auto it = sharded.begin_ascending_order(); it != sharded.end_ascending_order(); ++it) {
+            total -= *it;  // Shard sorts in parallel, then loser-tree merge
+        }
+        auto stop = Clock::now();
+        sink = total;
+        std::cout << "  n=2000000  shards=" << std::setw(2) << shardCount << "  single "
+                  << std::setprecision(0) << std::chrono::duration<double, std::milli>(mid - start).count() << " ms  sharded "
+                  << std::chrono::duration<double, std::milli>(stop - mid).count() << " ms" << std::endl;  // Print row
+    }
+    return 0;  // Return success code
+}
@@ -0,0 +1,369 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef CONCURRENTMYCONTAINER_HPP  // Header guard to prevent multiple inclusions of this file
+#define CONCURRENTMYCONTAINER_HPP
+
+#include <atomic>        // Include atomic header for the lock-free version counter
+#include <mutex>         // Include mutex header for std::unique_lock
+#include <shared_mutex>  // Include shared_mutex header for std::shared_timed_mutex
+#include <iostream>      // Include iostream header for output streaming
+#include <vector>        // Include vector header for append buffers
+#include <array>         // Include array header for the append shards
+#include "MyContainer.hpp"  // Include header for the wrapped container
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Thread-safe MyContainer: any number of readers, writers serialized.
+     *
+     * Writers take an exclusive lock. Readers take a shared lock only while an iterator is built;
+     * every iterator is a snapshot iterator (IterationMode::Snapshot) over copy-on-write data and an
+     * eagerly sorted, immutable permutation, so it can be used after the lock is released while writers
+     * continue. The first reader after a write sorts under the exclusive lock once; later readers share it.
+     *
+     * High-rate producers can use addElementBuffered() instead of addElement(): each thread appends to its
+     * own buffer shard without touching the container lock, and buffers are published in bulk by flush(),
+     * which every begin_*() and end_*() call runs first.
+     *
+     * Separately built begin_*() and end_*() iterators may pin different versions; a snapshot iterator
+     * still stops at the end of its own data. The views build both ends under one lock, on one snapshot.
+     */
+    template<typename T> // Template class definition for ConcurrentMyContainer
+    class ConcurrentMyContainer {
+    private:
+        mutable MyContainer<T> inner;            // Wrapped container, always in snapshot mode and eager sort mode; begin_*() may publish into it
+        mutable std::shared_timed_mutex mutex;   // Shared for readers, exclusive for writers
+        mutable std::atomic<size_t> version{0};  // Mirrors inner.getVersion(); readable without the lock
+        mutable size_t sortedVersion = static_cast<size_t>(-1);  // Version inner's sorted permutation was built at
+
+        static const size_t APPEND_SHARDS = 16;  // Producer buffers; threads beyond this share shards round-robin
+
+        struct AppendShard {
+            std::mutex mutex;           // Taken by its producer, and briefly by flush()
+            std::vector<T> pending;     // Elements appended but not yet published
+            char padding[64];           // Keeps neighbouring shards off the same cache line
+        };
+
+        mutable std::array<AppendShard, APPEND_SHARDS> shards;  // Per-thread append buffers
+        mutable std::atomic<size_t> pendingCount{0};            // Buffered elements across all shards
+
+        /**
+         * @return Shard owned by the calling thread
+         * @throws None
+         */
+        static size_t shardIndex() {  // Stable per thread
+            static std::atomic<size_t> nextShard{0};  // Round-robin assignment
+            static thread_local size_t index = nextShard.fetch_add(1) % APPEND_SHARDS;
+            return index;
+        }
+
+        /**
+         * @return None
+         * @throws None
+         */
+        // Caller holds the exclusive lock; shards are drained in index order, each in its producer's order
+        void publishPending() const {  // Move buffered elements into the container
+            std::vector<T> batch;  // Swapped out so producers are blocked only for the swap
+            for (AppendShard& shard : shards) {
+                {
+                    std::lock_guard<std::mutex> lock(shard.mutex);
+                    batch.swap(shard.pending);
+                }
+                for (const T& value : batch) {
+                    inner.addElement(value);
+                }
+                pendingCount.fetch_sub(batch.size());
+                batch.clear();  // Keep capacity for the next shard
+            }
+            version.store(inner.getVersion());  // Publish the new version
+        }
+
+        /**
+         * @param make Callable building an iterator or a view from the wrapped container
+         * @return Iterator or view built while the permutation is current
+         * @throws None
+         */
+        // Fast path under the shared lock; the first reader after a write sorts under the exclusive lock
+        template<typename Make>
+        auto sortedIterator(Make make) const -> decltype(make(inner)) {  // Build an ordered iterator
+            flush();  // Readers see everything appended before they started
+            {
+                std::shared_lock<std::shared_timed_mutex> lock(mutex);  // Concurrent with other readers
+                if (sortedVersion == inner.getVersion()) {  // Permutation already shared
+                    return make(inner);
+                }
+            }
+            std::unique_lock<std::shared_timed_mutex> lock(mutex);  // Sorting writes the cache
+            inner.getSortedPermutation();  // Builds, merges or patches as MyContainer does
+            sortedVersion = inner.getVersion();
+            return make(inner);
+        }
+
+        /**
+         * @param make Callable building an iterator or a view from the wrapped container
+         * @return Iterator or view built under the shared lock
+         * @throws None
+         */
+        template<typename Make>
+        auto plainIterator(Make make) const -> decltype(make(inner)) {  // Build an unordered iterator
+            flush();  // Readers see everything appended before they started
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);  // Concurrent with other readers
+            return make(inner);
+        }
+
+    public:
+        /**
+         * @throws None
+         */
+        ConcurrentMyContainer() {  // Default constructor
+            inner.setIterationMode(IterationMode::Snapshot);  // Iterators outlive the lock
+            inner.setSortMode(SortMode::Eager);  // Complete permutations are never written by readers
+        }
+
+        ConcurrentMyContainer(const ConcurrentMyContainer&) = delete;             // Not copyable; use snapshot()
+        ConcurrentMyContainer& operator=(const ConcurrentMyContainer&) = delete;  // Not assignable
+
+        /**
+         * @param value Element to add to the container
+         * @return None
+         * @throws None
+         */
+        void addElement(const T& value) {  // Add an element (exclusive)
+            std::unique_lock<std::shared_timed_mutex> lock(mutex);
+            inner.addElement(value);
+            version.store(inner.getVersion());  // Publish the new version
+        }
+
+        /**
+         * @param value Element to add to the calling thread's append buffer
+         * @return None
+         * @throws None
+         */
+        // Producers on different threads never contend with each other or with readers; the element
+        // becomes visible (and counted by size() and getVersion()) at the next flush()
+        void addElementBuffered(const T& value) {  // Add an element without taking the container lock
+            AppendShard& shard = shards[shardIndex()];
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);  // Uncontended unless flush() is draining it
+                shard.pending.push_back(value);
+            }
+            pendingCount.fetch_add(1);
+        }
+
+        /**
+         * @return None
+         * @throws None
+         */
+        void flush() const {  // Publish every buffered element
+            if (pendingCount.load() == 0) {
+                return;  // Common case: nothing buffered, no lock taken
+            }
+            std::unique_lock<std::shared_timed_mutex> lock(mutex);
+            publishPending();
+        }
+
+        /**
+         * @param value Element to remove from the container
+         * @return None
+         * @throws std::runtime_error If element is not found
+         */
+        void removeElement(const T& value) {  // Remove an element (exclusive)
+            std::unique_lock<std::shared_timed_mutex> lock(mutex);
+            publishPending();  // Buffered elements can be removed too
+            inner.removeElement(value);
+            version.store(inner.getVersion());  // Publish the new version
+        }
+
+        /**
+         * @return Number of elements in the container
+         * @throws None
+         */
+        size_t size() const {  // Return the number of elements
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            return inner.size();
+        }
+
+        /**
+         * @return Current version of the container, read without locking
+         * @throws None
+         */
+        size_t getVersion() const {  // Return current version number
+            return version.load();
+        }
+
+        /**
+         * @return Independent MyContainer holding the current elements
+         * @throws None
+         */
+        // O(1): the copy shares the data vector and permutation until either side writes
+        MyContainer<T> snapshot() const {  // Consistent single-threaded view
+            std::shared_lock<std::shared_timed_mutex> lock(mutex);
+            MyContainer<T> copy = inner;
+            copy.setIterationMode(IterationMode::Checked);  // Plain container semantics for the caller
+            return copy;
+        }
+
+        /**
+         * @param os Output stream to write to
+         * @param container ConcurrentMyContainer to print
+         * @return Reference to the output stream
+         * @throws None
+         */
+        friend std::ostream& operator<<(std::ostream& os, const ConcurrentMyContainer<T>& container) {  // Stream output operator
+            std::shared_lock<std::shared_timed_mutex> lock(container.mutex);
+            return os << container.inner;
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of ascending order
+         * @throws None
+         */
+        AscendingOrderIterator<T> begin_ascending_order() const {
+            return sortedIterator([](const MyContainer<T>& c) { return c.begin_ascending_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of ascending order
+         * @throws None
+         */
+        AscendingOrderIterator<T> end_ascending_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_ascending_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of descending order
+         * @throws None
+         */
+        DescendingOrderIterator<T> begin_descending_order() const {
+            return sortedIterator([](const MyContainer<T>& c) { return c.begin_descending_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of descending order
+         * @throws None
+         */
+        DescendingOrderIterator<T> end_descending_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_descending_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of side-cross order
+         * @throws None
+         */
+        SideCrossOrderIterator<T> begin_side_cross_order() const {
+            return sortedIterator([](const MyContainer<T>& c) { return c.begin_side_cross_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of side-cross order
+         * @throws None
+         */
+        SideCrossOrderIterator<T> end_side_cross_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_side_cross_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of reverse order
+         * @throws None
+         */
+        ReverseOrderIterator<T> begin_reverse_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.begin_reverse_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of reverse order
+         * @throws None
+         */
+        ReverseOrderIterator<T> end_reverse_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_reverse_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of insertion order
+         * @throws None
+         */
+        OrderIterator<T> begin_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.begin_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of insertion order
+         * @throws None
+         */
+        OrderIterator<T> end_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the beginning of middle-out order
+         * @throws None
+         */
+        MiddleOutOrderIterator<T> begin_middle_out_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.begin_middle_out_order(); });
+        }
+
+        /**
+         * @return Snapshot iterator to the end of middle-out order
+         * @throws None
+         */
+        MiddleOutOrderIterator<T> end_middle_out_order() const {
+            return plainIterator([](const MyContainer<T>& c) { return c.end_middle_out_order(); });
+        }
+
+        /**
+         * @return View over ascending order built from one snapshot
+         * @throws None
+         */
+        OrderView<AscendingOrderIterator<T>> ascending() const {  // Range over ascending order
+            return sortedIterator([](const MyContainer<T>& c) { return c.ascending(); });  // Both ends on one snapshot
+        }
+
+        /**
+         * @return View over descending order built from one snapshot
+         * @throws None
+         */
+        OrderView<DescendingOrderIterator<T>> descending() const {  // Range over descending order
+            return sortedIterator([](const MyContainer<T>& c) { return c.descending(); });  // Both ends on one snapshot
+        }
+
+        /**
+         * @return View over side-cross order built from one snapshot
+         * @throws None
+         */
+        OrderView<SideCrossOrderIterator<T>> side_cross() const {  // Range over side-cross order
+            return sortedIterator([](const MyContainer<T>& c) { return c.side_cross(); });  // Both ends on one snapshot
+        }
+
+        /**
+         * @return View over reverse order built from one snapshot
+         * @throws None
+         */
+        OrderView<ReverseOrderIterator<T>> reverse() const {  // Range over reverse order
+            return plainIterator([](const MyContainer<T>& c) { return c.reverse(); });  // Both ends on one snapshot
+        }
+
+        /**
+         * @return View over insertion order built from one snapshot
+         * @throws None
+         */
+        OrderView<OrderIterator<T>> order() const {  // Range over insertion order
+            return plainIterator([](const MyContainer<T>& c) { return c.order(); });  // Both ends on one snapshot
+        }
+
+        /**
+         * @return View over middle-out order built from one snapshot
+         * @throws None
+         */
+        OrderView<MiddleOutOrderIterator<T>> middle_out() const {  // Range over middle-out order
+            return plainIterator([](const MyContainer<T>& c) { return c.middle_out(); });  // Both ends on one snapshot
+        }
+    };
+
+    template<typename T>
+    const size_t ConcurrentMyContainer<T>::APPEND_SHARDS;  // Out-of-class definition for the ODR-used constant
+
+} // Namespace ariel
+
+#endif //CONCURRENTMYCONTAINER_HPP  // Header guard
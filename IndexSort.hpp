@@ -0,0 +1,525 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef INDEXSORT_HPP  // Header guard to prevent multiple inclusions of this file
+#define INDEXSORT_HPP
+
+#include <vector>       // Include vector header for index and record buffers
+#include <algorithm>    // Include algorithm header for std::sort
+#include <cstddef>      // Include cstddef header for size_t
+#include <cstdint>      // Include cstdint header for fixed-width key types
+#include <cstring>      // Include cstring header for std::memcpy
+#include <type_traits>  // Include type_traits header for arithmetic type dispatch
+#include <thread>       // Include thread header for hardware_concurrency
+#include <utility>      // Include utility header for std::pair
+#include "TaskScheduler.hpp"  // Include header for the shared work-stealing scheduler
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Maps a value to an unsigned key whose unsigned order matches the value order.
+     * Only defined (Enabled == true) for integral types and 32/64-bit IEEE-754 floating point.
+     *
+     * NaN policy: every NaN maps to the largest key, so NaNs sort after +infinity and
+     * keep insertion order among themselves. -0.0 maps to the same key as +0.0,
+     * matching operator< which treats them as equal.
+     */
+    template<typename T, typename Enable = void>
+    struct RadixKey {
+        static const bool Enabled = false;  // No key transform for this type
+    };
+
+    template<typename T>
+    struct RadixKey<T, typename std::enable_if<std::is_integral<T>::value>::type> {
+        static const bool Enabled = true;  // Integral types are radix sortable
+        using Key = typename std::make_unsigned<typename std::conditional<std::is_same<T, bool>::value, unsigned char, T>::type>::type;  // Same-width unsigned key
+
+        static Key of(T value) {  // Flip the sign bit so negative values order first
+            Key key = static_cast<Key>(value);  // Two's complement bits
+            if (std::is_signed<T>::value) {
+                key ^= static_cast<Key>(Key(1) << (sizeof(Key) * 8 - 1));  // Flip sign bit
+            }
+            return key;
+        }
+    };
+
+    template<typename T>
+    struct RadixKey<T, typename std::enable_if<std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>::type> {
+        static const bool Enabled = true;  // IEEE-754 float and double are radix sortable
+        using Key = typename std::conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type;  // Same-width unsigned key
+
+        static Key of(T value) {  // IEEE-754 total order transform
+            if (value != value) {
+                return ~Key(0);  // NaN sorts last
+            }
+            if (value == T(0)) {
+                value = T(0);  // Fold -0.0 into +0.0
+            }
+            Key bits;  // Raw bit pattern
+            std::memcpy(&bits, &value, sizeof(bits));  // Type-pun safely
+            const Key sign = Key(1) << (sizeof(Key) * 8 - 1);  // Sign bit mask
+            return (bits & sign) ? ~bits : (bits | sign);  // Negatives reversed, positives above them
+        }
+    };
+
+    /**
+     * @brief Orders indices by the values they point to, breaking ties by index.
+     * The tie-break makes every sorting strategy produce the same (stable) permutation.
+     * Radix-sortable types compare by RadixKey so comparison and radix sorts agree (including NaN).
+     */
+    template<typename T, bool ByKey = RadixKey<T>::Enabled>
+    struct IndexLess {
+        const std::vector<T>& data;  // Values the indices refer to
+
+        bool operator()(size_t a, size_t b) const {  // Strict weak ordering on indices
+            if (data[a] < data[b]) return true;  // Smaller value first
+            if (data[b] < data[a]) return false;  // Larger value later
+            return a < b;  // Equal values keep insertion order
+        }
+
+        bool equivalent(size_t a, size_t b) const {  // Same value, whatever the indices
+            return !(data[a] < data[b]) && !(data[b] < data[a]);
+        }
+    };
+
+    template<typename T>
+    struct IndexLess<T, true> {
+        const std::vector<T>& data;  // Values the indices refer to
+
+        bool operator()(size_t a, size_t b) const {  // Strict weak ordering on indices
+            auto ka = RadixKey<T>::of(data[a]);  // Key of first value
+            auto kb = RadixKey<T>::of(data[b]);  // Key of second value
+            return ka < kb || (ka == kb && a < b);  // Key order, then insertion order
+        }
+
+        bool equivalent(size_t a, size_t b) const {  // Same key, whatever the indices
+            return RadixKey<T>::of(data[a]) == RadixKey<T>::of(data[b]);
+        }
+    };
+
+    /**
+     * @brief Key copied next to each index when sorting contiguous records.
+     * Radix-sortable types use their unsigned RadixKey; other cheap-to-copy types use the value itself.
+     */
+    template<typename T, bool ByKey = RadixKey<T>::Enabled>
+    struct SortKey {
+        using Type = T;  // The value is its own key
+        static const T& of(const T& value) { return value; }  // Copy the value as is
+    };
+
+    template<typename T>
+    struct SortKey<T, true> {
+        using Type = typename RadixKey<T>::Key;  // Unsigned key with the same order
+        static Type of(const T& value) { return RadixKey<T>::of(value); }  // Transform once per element
+    };
+
+    /**
+     * @brief True when T is cheap enough to copy into (key, index) records for sorting.
+     */
+    template<typename T>
+    struct UseRecordSort : std::integral_constant<bool,
+        RadixKey<T>::Enabled  // Arithmetic types store their unsigned key
+        || (std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value && sizeof(T) <= 16)> {  // Small plain values
+    };
+
+    /**
+     * @param first Start of the index range
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return None
+     * @throws None
+     */
+    // Sorts contiguous (key, index) records so comparisons never touch data; then extracts the permutation
+    template<typename T>
+    void recordSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        using Key = typename SortKey<T>::Type;  // Key stored in each record
+        struct Record {
+            Key key;       // Copy of (or key for) the value
+            size_t index;  // Index into data
+        };
+
+        size_t n = static_cast<size_t>(last - first);  // Number of indices
+        std::vector<Record> records(n);  // Contiguous records
+        for (size_t i = 0; i < n; ++i) {
+            records[i].key = SortKey<T>::of(data[first[i]]);  // One random load per element
+            records[i].index = first[i];
+        }
+        std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+            if (a.key < b.key) return true;  // Smaller key first
+            if (b.key < a.key) return false;  // Larger key later
+            return a.index < b.index;  // Equal keys keep insertion order
+        });
+        for (size_t i = 0; i < n; ++i) {
+            first[i] = records[i].index;  // Extract permutation
+        }
+    }
+
+    /**
+     * @param first Start of the index range
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return None
+     * @throws None
+     */
+    // Comparison sort: contiguous records for cheap-to-copy values, bare indices otherwise
+    template<typename T>
+    typename std::enable_if<UseRecordSort<T>::value>::type
+    comparisonSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        recordSortIndices(first, last, data);  // Keys live next to indices
+    }
+
+    template<typename T>
+    typename std::enable_if<!UseRecordSort<T>::value>::type
+    comparisonSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        std::sort(first, last, IndexLess<T>{data});  // Expensive values: compare through data
+    }
+
+    static const size_t RADIX_SORT_THRESHOLD = 2048;  // Below this many indices a comparison sort wins
+    static const size_t COUNTING_SORT_RANGE_FACTOR = 4;  // Counting sort when the key range is at most this many times n
+
+    /**
+     * @param first Start of the index range, in increasing index order
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return None
+     * @throws None
+     */
+    // LSD radix sort on (key, index) records, one byte per pass; passes where every key shares the byte are skipped
+    template<typename T>
+    void radixSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        using Key = typename RadixKey<T>::Key;  // Unsigned key type
+        struct Record {
+            Key key;       // Transformed value
+            size_t index;  // Index into data
+        };
+
+        size_t n = static_cast<size_t>(last - first);  // Number of indices
+        if (n == 0) {
+            return;  // Nothing to sort
+        }
+        std::vector<Record> records(n);  // Contiguous (key, index) records
+        std::vector<Record> buffer(n);   // Scatter target
+        for (size_t i = 0; i < n; ++i) {
+            records[i].key = RadixKey<T>::of(data[first[i]]);  // One random load per element, not per comparison
+            records[i].index = first[i];
+        }
+
+        for (size_t shift = 0; shift < sizeof(Key) * 8; shift += 8) {  // Least significant byte first
+            size_t count[257] = {0};  // Histogram, offset by one for the prefix sum
+            for (size_t i = 0; i < n; ++i) {
+                ++count[((records[i].key >> shift) & 0xFF) + 1];  // Count byte values
+            }
+            if (count[((records[0].key >> shift) & 0xFF) + 1] == n) {
+                continue;  // Every key shares this byte; the pass would not move anything
+            }
+            for (size_t b = 0; b < 256; ++b) {
+                count[b + 1] += count[b];  // Prefix sum gives bucket starts
+            }
+            for (size_t i = 0; i < n; ++i) {
+                buffer[count[(records[i].key >> shift) & 0xFF]++] = records[i];  // Stable scatter
+            }
+            records.swap(buffer);  // Output becomes next input
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            first[i] = records[i].index;  // Extract permutation
+        }
+    }
+
+    /**
+     * @param first Start of the index range, in increasing index order
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return True if the range was sorted, false if the key range is too wide for a counting sort
+     * @throws None
+     */
+    // One pass finds the key range; if it is small relative to n, a stable counting sort runs in O(n + range)
+    template<typename T>
+    bool countingSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        using Key = typename RadixKey<T>::Key;  // Unsigned key type
+        size_t n = static_cast<size_t>(last - first);  // Number of indices
+        if (n == 0) {
+            return true;  // Nothing to sort
+        }
+
+        Key lo = RadixKey<T>::of(data[first[0]]);  // Smallest key seen
+        Key hi = lo;  // Largest key seen
+        for (size_t i = 1; i < n; ++i) {
+            Key key = RadixKey<T>::of(data[first[i]]);  // Key of this element
+            lo = key < lo ? key : lo;  // Track minimum
+            hi = key > hi ? key : hi;  // Track maximum
+        }
+        if (static_cast<std::uint64_t>(hi - lo) >= static_cast<std::uint64_t>(n) * COUNTING_SORT_RANGE_FACTOR) {
+            return false;  // Range too wide: histogram would dominate
+        }
+
+        size_t range = static_cast<size_t>(hi - lo) + 1;  // Number of distinct possible keys
+        std::vector<size_t> count(range + 1, 0);  // Dense histogram, offset by one for the prefix sum
+        for (size_t i = 0; i < n; ++i) {
+            ++count[static_cast<size_t>(RadixKey<T>::of(data[first[i]]) - lo) + 1];  // Count each key
+        }
+        for (size_t k = 0; k < range; ++k) {
+            count[k + 1] += count[k];  // Prefix sum gives bucket starts
+        }
+        std::vector<size_t> sorted(n);  // Output permutation
+        for (size_t i = 0; i < n; ++i) {
+            sorted[count[static_cast<size_t>(RadixKey<T>::of(data[first[i]]) - lo)]++] = first[i];  // Stable scatter
+        }
+        std::copy(sorted.begin(), sorted.end(), first);  // Write back
+        return true;
+    }
+
+    template<typename T>
+    typename std::enable_if<std::is_integral<T>::value, bool>::type
+    tryCountingSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        return countingSortIndices(first, last, data);  // Integers may have a narrow range
+    }
+
+    template<typename T>
+    typename std::enable_if<!std::is_integral<T>::value, bool>::type
+    tryCountingSortIndices(std::vector<size_t>::iterator, std::vector<size_t>::iterator, const std::vector<T>&) {
+        return false;  // Counting sort only applies to integers
+    }
+
+    /**
+     * @param first Start of the index range, in increasing index order
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return None
+     * @throws None
+     */
+    // Counting sort for narrow integer ranges, radix sort for large inputs, comparison sort otherwise
+    template<typename T>
+    typename std::enable_if<RadixKey<T>::Enabled>::type
+    sequentialSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        if (tryCountingSortIndices(first, last, data)) {
+            return;  // Narrow key range: sorted in O(n + range)
+        }
+        if (static_cast<size_t>(last - first) >= RADIX_SORT_THRESHOLD) {
+            radixSortIndices(first, last, data);  // Linear-time stable sort
+        } else {
+            comparisonSortIndices(first, last, data);  // Small input: comparison sort
+        }
+    }
+
+    template<typename T>
+    typename std::enable_if<!RadixKey<T>::Enabled>::type
+    sequentialSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        comparisonSortIndices(first, last, data);  // Generic types: comparison sort
+    }
+
+    /**
+     * @brief Tuning for the parallel index sort; adjust before sorting from other threads.
+     */
+    struct ParallelSortConfig {
+        size_t threads = std::thread::hardware_concurrency();  // Chunks sorted concurrently; 0 or 1 disables parallel sorting
+        size_t threshold = size_t(1) << 18;  // Smallest range worth sorting in parallel
+        TaskScheduler* scheduler = nullptr;  // Where chunks run; nullptr uses TaskScheduler::global()
+    };
+
+    /**
+     * @return Process-wide parallel sort configuration
+     * @throws None
+     */
+    inline ParallelSortConfig& parallelSortConfig() {  // Shared configuration
+        static ParallelSortConfig config;  // Created on first use
+        return config;
+    }
+
+    /**
+     * @param first Start of the index range, in increasing index order
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @param threads Number of chunks to sort concurrently
+     * @param scheduler Scheduler the chunk sorts and merges run on
+     * @return None
+     * @throws Any exception thrown while sorting a chunk
+     */
+    // Parallel merge sort: each chunk is sorted with the sequential backends, then pairs of runs are merged in parallel rounds
+    template<typename T>
+    void parallelSortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last,
+                             const std::vector<T>& data, size_t threads,
+                             TaskScheduler& scheduler = TaskScheduler::global()) {
+        size_t n = static_cast<size_t>(last - first);  // Number of indices
+        size_t chunks = std::max<size_t>(1, std::min(threads, n));  // One run per thread
+        std::vector<size_t> bounds(chunks + 1);  // Run boundaries
+        for (size_t i = 0; i <= chunks; ++i) {
+            bounds[i] = n * i / chunks;  // Even split; each run stays in increasing index order
+        }
+
+        {
+            TaskGroup sorts(scheduler);  // Fork one sort per run
+            for (size_t i = 0; i < chunks; ++i) {
+                auto lo = first + bounds[i];  // Run start
+                auto hi = first + bounds[i + 1];  // Run end
+                sorts.run([lo, hi, &data] { sequentialSortIndices<T>(lo, hi, data); });  // Sort run
+            }
+            sorts.wait();  // Join, helping with the runs meanwhile
+        }
+
+        std::vector<size_t> buffer(n);  // Merge target
+        size_t* src = &*first;  // Current runs
+        size_t* dst = buffer.data();  // Next runs
+        IndexLess<T> less{data};  // Same order as every backend
+        while (bounds.size() > 2) {  // More than one run left
+            std::vector<size_t> merged;  // Boundaries after this round
+            TaskGroup merges(scheduler);  // Fork one merge per pair of runs
+            for (size_t j = 0; j + 1 < bounds.size(); j += 2) {
+                size_t lo = bounds[j];  // Left run start
+                size_t mid = bounds[j + 1];  // Left run end / right run start
+                size_t hi = j + 2 < bounds.size() ? bounds[j + 2] : mid;  // Right run end (empty if unpaired)
+                merged.push_back(lo);
+                merges.run([=] {
+                    std::merge(src + lo, src + mid, src + mid, src + hi, dst + lo, less);  // Stable merge of two runs
+                });
+            }
+            merged.push_back(n);
+            merges.wait();  // Join the round
+            bounds.swap(merged);  // Half as many runs
+            std::swap(src, dst);  // Merged output feeds the next round
+        }
+        if (src != &*first) {
+            std::copy(src, src + n, first);  // Result ended in the buffer
+        }
+    }
+
+    /**
+     * @param first Start of the index range, in increasing index order
+     * @param last End of the index range
+     * @param data Values the indices refer to
+     * @return None
+     * @throws None
+     */
+    // Entry point used by SortedPermutation: parallel for large ranges when configured, sequential otherwise
+    template<typename T>
+    void sortIndices(std::vector<size_t>::iterator first, std::vector<size_t>::iterator last, const std::vector<T>& data) {
+        const ParallelSortConfig& config = parallelSortConfig();  // Current tuning
+        size_t n = static_cast<size_t>(last - first);  // Number of indices
+        if (config.threads <= 1 || n < config.threshold) {
+            sequentialSortIndices(first, last, data);  // Single thread
+            return;
+        }
+        if (tryCountingSortIndices(first, last, data)) {
+            return;  // Narrow key range is already linear; not worth splitting
+        }
+        TaskScheduler& scheduler = config.scheduler ? *config.scheduler : TaskScheduler::global();  // Injected or shared
+        parallelSortIndices(first, last, data, config.threads, scheduler);  // Split across the scheduler
+    }
+
+    /**
+     * @brief Projection that returns the element itself (the default for comparator-only sorts).
+     */
+    struct IdentityProjection {
+        template<typename U>
+        const U& operator()(const U& value) const {  // No key extraction
+            return value;
+        }
+    };
+
+    /**
+     * @param proj Callable projection
+     * @param value Element to project
+     * @return proj(value)
+     * @throws Whatever proj throws
+     */
+    template<typename Projection, typename T>
+    auto project(const Projection& proj, const T& value) -> decltype(proj(value)) {  // Call a function object
+        return proj(value);
+    }
+
+    /**
+     * @param member Pointer to a data member of T
+     * @param value Element to project
+     * @return value.*member
+     * @throws None
+     */
+    template<typename M, typename C, typename T>
+    const M& project(M C::* member, const T& value) {  // Read a field, e.g. &Point::x
+        return value.*member;
+    }
+
+    /**
+     * @param ascending Indices in ascending order, equal elements by insertion order
+     * @param equivalent Callable; equivalent(r, r + 1) is true if ranks r and r + 1 hold equal elements
+     * @return The same indices from largest to smallest, equal elements still by insertion order
+     * @throws Whatever equivalent throws
+     */
+    // Walks the runs of equal elements from the top, copying each run forwards: O(n), n - 1 comparisons
+    template<typename Equivalent>
+    std::vector<size_t> reverseKeepingTies(const std::vector<size_t>& ascending, Equivalent equivalent) {
+        std::vector<size_t> descending;
+        descending.reserve(ascending.size());
+        for (size_t hi = ascending.size(); hi > 0;) {
+            size_t lo = hi - 1;  // First rank of the run ending at hi - 1
+            while (lo > 0 && equivalent(lo - 1, lo)) {
+                --lo;
+            }
+            descending.insert(descending.end(), ascending.begin() + lo, ascending.begin() + hi);  // Run in insertion order
+            hi = lo;
+        }
+        return descending;
+    }
+
+    /**
+     * @param data Values to order
+     * @param comp Strict weak order on the projected keys
+     * @param descending If not null, receives the indices from largest to smallest, ties by index
+     * @return Indices into data ordered by comp on the elements themselves; ties by index
+     * @throws Whatever comp throws
+     */
+    template<typename T, typename Compare>
+    std::vector<size_t> sortIndicesBy(const std::vector<T>& data, Compare comp, IdentityProjection,
+                                      std::vector<size_t>* descending = nullptr) {  // Nothing to cache
+        std::vector<size_t> indices(data.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = i;  // Initialize with 0, 1, 2, ...
+        }
+        std::stable_sort(indices.begin(), indices.end(), [&data, &comp](size_t a, size_t b) {
+            return comp(data[a], data[b]);  // Stable: equal elements keep insertion order
+        });
+        if (descending) {
+            *descending = reverseKeepingTies(indices, [&](size_t r, size_t next) {
+                return !comp(data[indices[r]], data[indices[next]]);  // Sorted, so not less means equal
+            });
+        }
+        return indices;
+    }
+
+    /**
+     * @param data Values to order
+     * @param comp Strict weak order on the projected keys
+     * @param proj Projection applied to each element: a callable or a pointer to a data member
+     * @param descending If not null, receives the indices from largest to smallest key, ties by index
+     * @return Indices into data ordered by comp on proj(element); ties by index
+     * @throws Whatever comp or proj throws
+     */
+    // Every key is projected exactly once into a (key, index) record, so comparisons never re-run proj
+    template<typename T, typename Compare, typename Projection>
+    std::vector<size_t> sortIndicesBy(const std::vector<T>& data, Compare comp, Projection proj,
+                                      std::vector<size_t>* descending = nullptr) {
+        typedef typename std::decay<decltype(project(proj, data[0]))>::type Key;  // Cached key type
+        std::vector<std::pair<Key, size_t>> records;
+        records.reserve(data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            records.emplace_back(project(proj, data[i]), i);  // n projections in total
+        }
+        std::stable_sort(records.begin(), records.end(),
+                         [&comp](const std::pair<Key, size_t>& a, const std::pair<Key, size_t>& b) {
+                             return comp(a.first, b.first);  // Stable: equal keys keep insertion order
+                         });
+        std::vector<size_t> indices(records.size());
+        for (size_t i = 0; i < records.size(); ++i) {
+            indices[i] = records[i].second;  // Drop the keys
+        }
+        if (descending) {
+            *descending = reverseKeepingTies(indices, [&](size_t r, size_t next) {
+                return !comp(records[r].first, records[next].first);  // Cached keys, no projection
+            });
+        }
+        return indices;
+    }
+
+} // Namespace ariel
+
+#endif //INDEXSORT_HPP  // Header guard
@@ -0,0 +1,34 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef ITERATORCHECKS_HPP  // Header guard to prevent multiple inclusions of this file
+#define ITERATORCHECKS_HPP
+
+#include <stdexcept>   // Include stdexcept header for the checked-mode exceptions
+
+// Iterator validity policy, selected at compile time.
+//
+// By default every iterator operation verifies the container version and the iterator bounds and
+// throws std::runtime_error / std::out_of_range. Defining ARIEL_UNCHECKED_ITERATORS before including
+// any container header (e.g. -DARIEL_UNCHECKED_ITERATORS) turns those checks into assert()s, which
+// disappear entirely with -DNDEBUG, and marks operator*, operator-> and operator++ noexcept.
+// The policy must be the same in every translation unit of a program.
+
+#ifdef ARIEL_UNCHECKED_ITERATORS
+
+#include <cassert>     // Include cassert header for debug-only checks
+
+#define ARIEL_ITERATOR_NOEXCEPT noexcept  // Unchecked operators never throw
+#define ARIEL_ITERATOR_CHECK(failed, Exception, message) \
+    do { static_cast<void>(sizeof(failed)); static_cast<void>(message); assert(!(failed) && message); } while (false)  // Debug builds only; the casts keep -DNDEBUG builds warning-free
+
+#else
+
+#define ARIEL_ITERATOR_NOEXCEPT  // Checked operators may throw
+#define ARIEL_ITERATOR_CHECK(failed, Exception, message) \
+    do { if (failed) { throw Exception(message); } } while (false)  // Throw on every build
+
+#endif
+
+#endif //ITERATORCHECKS_HPP  // Header guard
@@ -0,0 +1,116 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef LOSERTREE_HPP  // Header guard to prevent multiple inclusions of this file
+#define LOSERTREE_HPP
+
+#include <vector>      // Include vector header for the tournament nodes
+#include <utility>     // Include utility header for std::move and std::swap
+#include <cstddef>     // Include cstddef header for size_t
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Tournament tree of losers for a k-way merge.
+     *
+     * Runs must provide count(), exhausted(r), before(a, b) (strict order of the heads of two live runs)
+     * and advance(r). Each internal node keeps the loser of its match, so replacing the winner replays
+     * only the log2(k) matches on its path to the root, with one comparison per level.
+     */
+    template<typename Runs> // Template class definition for LoserTree
+    class LoserTree {
+    private:
+        Runs runs;                   // Merge sources
+        std::vector<size_t> losers;  // losers[0] is the overall winner; losers[1..k) hold each match's loser
+
+        /**
+         * @param a Run index
+         * @param b Run index
+         * @return True if run a's head comes first; exhausted runs lose to every live run
+         * @throws None
+         */
+        bool beats(size_t a, size_t b) const {  // Play one match
+            if (runs.exhausted(a)) {
+                return false;
+            }
+            if (runs.exhausted(b)) {
+                return true;
+            }
+            return runs.before(a, b);
+        }
+
+    public:
+        /**
+         * @throws None
+         */
+        LoserTree() = default;  // Empty merge over default-constructed (empty) runs
+
+        /**
+         * @param sources Runs to merge
+         * @throws None
+         */
+        explicit LoserTree(Runs sources)  // Play the initial tournament: O(k)
+            : runs(std::move(sources)), losers(runs.count(), 0) {  // No allocation for an empty merge
+            size_t k = runs.count();  // Number of runs; leaf r sits at node k + r
+            if (k < 2) {
+                return;  // Zero or one run: run 0 always wins
+            }
+            std::vector<size_t> winners(2 * k);  // Winner of each subtree, only needed while building
+            for (size_t r = 0; r < k; ++r) {
+                winners[k + r] = r;  // Leaves
+            }
+            for (size_t node = k - 1; node >= 1; --node) {
+                size_t left = winners[2 * node];  // Left subtree winner
+                size_t right = winners[2 * node + 1];  // Right subtree winner
+                bool leftWins = beats(left, right);
+                winners[node] = leftWins ? left : right;  // Moves up
+                losers[node] = leftWins ? right : left;   // Stays here
+            }
+            losers[0] = winners[1];  // Champion
+        }
+
+        /**
+         * @return True if every run is exhausted
+         * @throws None
+         */
+        bool empty() const {
+            return runs.count() == 0 || runs.exhausted(losers[0]);
+        }
+
+        /**
+         * @return Run whose head comes first, must not be called when empty()
+         * @throws None
+         */
+        size_t top() const {
+            return losers[0];
+        }
+
+        /**
+         * @return Merge sources, for reading the winner's head
+         * @throws None
+         */
+        const Runs& sources() const {
+            return runs;
+        }
+
+        /**
+         * @return None
+         * @throws None
+         */
+        void pop() {  // Advance the winning run and replay its path: O(log k)
+            size_t winner = losers[0];
+            runs.advance(winner);
+            size_t k = runs.count();
+            for (size_t node = (k + winner) / 2; node >= 1; node /= 2) {
+                if (beats(losers[node], winner)) {
+                    std::swap(losers[node], winner);  // Stored loser wins this match now
+                }
+            }
+            losers[0] = winner;
+        }
+    };
+
+} // Namespace ariel
+
+#endif //LOSERTREE_HPP  // Header guard
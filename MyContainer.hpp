@@ -9,34 +9,160 @@ Mail - ariel.yaacobi@msmail.ariel.ac.il
 #include <iostream>    // Include iostream header for output streaming
 #include <algorithm>   // Include algorithm header for std::remove
 #include <stdexcept>   // Include stdexcept header for std::runtime_error
+#include <memory>      // Include memory header for std::shared_ptr
+#include <atomic>      // Include atomic header for the shared-data flag
+#include <mutex>       // Include mutex header for guarding the permutation caches
+#include <map>         // Include map header for the generated-permutation cache
+#include <typeindex>   // Include typeindex header for keying that cache by policy type
+#include <typeinfo>    // Include typeinfo header for typeid
+#include <type_traits> // Include type_traits header for std::is_empty
+#include "SortedPermutation.hpp"         // Include header for SortedPermutation
+#include "TaskScheduler.hpp"             // Include header for parallel traversal
 #include "AscendingOrderIterator.hpp"    // Include header for AscendingOrderIterator
 #include "DescendingOrderIterator.hpp"   // Include header for DescendingOrderIterator
 #include "ReverseOrderIterator.hpp"      // Include header for ReverseOrderIterator
 #include "SideCrossOrderIterator.hpp"    // Include header for SideCrossOrderIterator
 #include "OrderIterator.hpp"             // Include header for OrderIterator
 #include "MiddleOutOrderIterator.hpp"    // Include header for MiddleOutOrderIterator
+#include "OrderView.hpp"                 // Include header for range views
 
 namespace ariel { // Namespace ariel to encapsulate classes and functions
 
+    /**
+     * @brief Selects one of the six traversal orders for the parallel traversal methods.
+     */
+    enum class Order {
+        Ascending,   // Same as begin_ascending_order()
+        Descending,  // Same as begin_descending_order()
+        SideCross,   // Same as begin_side_cross_order()
+        Reverse,     // Same as begin_reverse_order()
+        Insertion,   // Same as begin_order()
+        MiddleOut    // Same as begin_middle_out_order()
+    };
+
+    /**
+     * @brief What iterators do when the container is modified while they are alive.
+     * Checked throws on the next access; Snapshot keeps reading the data as it was when the iterator was created.
+     */
+    enum class IterationMode {
+        Checked,   // Iterators read the live data and throw std::runtime_error after a modification
+        Snapshot   // Iterators pin an immutable copy-on-write snapshot of the data and its permutation
+    };
+
     template<typename T> // Template class definition for MyContainer
     class MyContainer {
     private:
-        std::vector<T> data;  // Vector to store container elements
+        // Shared copy-on-write: snapshot iterators and container copies hold the same vector until someone writes
+        std::shared_ptr<std::vector<T>> data = std::make_shared<std::vector<T>>();  // Vector to store container elements
+
+        // Pins are tracked explicitly rather than through data.use_count(): a relaxed reference count gives a
+        // writer no happens-before edge with a reader that just dropped the vector on another thread
+        struct SharedFlag {
+            mutable std::atomic<bool> set{false};  // Atomic: readers holding a shared lock may pin concurrently
+
+            SharedFlag() = default;
+            SharedFlag(const SharedFlag& other) : set(true) {  // Copies share the source's vector
+                other.set.store(true);
+            }
+            SharedFlag& operator=(const SharedFlag& other) {
+                set.store(true);
+                other.set.store(true);
+                return *this;
+            }
+        };
+        SharedFlag dataShared;  // Set once data was handed to a snapshot or a container copy; the next write copies
+        IterationMode iterationMode = IterationMode::Checked;  // Whether iterators pin a snapshot of the data
         size_t version = 0;  // Tracks container version for iterator validation
 
+        SortMode sortMode = SortMode::Eager;  // How the ascending permutation is built
+        // Const readers on several threads may fill the caches below at once, as with any const member of a standard container
+        mutable std::mutex cacheMutex;  // Guards sortedCache, generatedCache and projectedCache
+        // Invariant: sortedCache, when set, orders exactly data[0, sortedCache->size()); later elements are an unsorted tail
+        mutable std::shared_ptr<const SortedPermutation<T>> sortedCache;  // Ascending permutation, built lazily and shared with iterators
+        mutable size_t sortedCacheVersion = 0;    // Version the sorted cache was computed at
+
+        struct CachedPermutation {
+            std::shared_ptr<const std::vector<size_t>> indices;  // Data indices in the policy's order
+            size_t version = 0;                                  // Version they were generated at
+        };
+        mutable std::map<std::type_index, CachedPermutation> generatedCache;  // One entry per generating order policy
+
+        template<typename Compare, typename Projection>
+        struct ProjectionKey {};  // Names a (comparator, projection) type pair in projectedCache
+
+        struct CachedProjection {
+            std::shared_ptr<const SortedPermutation<T>> permutation;  // Ascending by comparator and projection
+            size_t version = 0;                                       // Version it was sorted at
+        };
+        mutable std::map<std::type_index, CachedProjection> projectedCache;  // One entry per stateless (comparator, projection)
+
+        /**
+         * @return Data vector that is safe to modify in place
+         * @throws None
+         */
+        std::vector<T>& mutableData() {  // Copy-on-write
+            if (dataShared.set.load()) {  // A snapshot or a container copy may still read this vector
+                data = std::make_shared<std::vector<T>>(*data);  // Writers get their own version; readers keep theirs
+                dataShared.set.store(false);  // Nobody else has seen the fresh vector
+            }
+            return *data;
+        }
+
+        /**
+         * @param other Container to copy
+         * @param lock Lock on other.cacheMutex, held until the copy is complete
+         * @throws None
+         */
+        MyContainer(const MyContainer& other, std::unique_lock<std::mutex>&& lock)
+            : data(other.data), dataShared(other.dataShared), iterationMode(other.iterationMode), version(other.version),
+              sortMode(other.sortMode), sortedCache(other.sortedCache), sortedCacheVersion(other.sortedCacheVersion),
+              generatedCache(other.generatedCache), projectedCache(other.projectedCache) {
+            static_cast<void>(lock);  // Only its lifetime matters
+        }
+
     public:
         /**
          * @throws None
          */
         MyContainer() = default;  // Default constructor
 
+        /**
+         * @param other Container to copy
+         * @throws None
+         */
+        MyContainer(const MyContainer& other)  // O(1): shares data and permutation until one side writes
+            : MyContainer(other, std::unique_lock<std::mutex>(other.cacheMutex)) {}  // A reader may be filling other's caches
+
+        /**
+         * @param other Container to copy
+         * @return Reference to this container
+         * @throws None
+         */
+        // Declaring copies also makes moves copy, so a moved-from container keeps its (shared) data
+        MyContainer& operator=(const MyContainer& other) {
+            if (this == &other) {
+                return *this;  // Self-assignment
+            }
+            std::lock_guard<std::mutex> lock(other.cacheMutex);  // A reader may be filling other's caches
+            data = other.data;
+            dataShared = other.dataShared;  // Marks both sides as sharing data
+            iterationMode = other.iterationMode;
+            version = other.version;
+            sortMode = other.sortMode;
+            sortedCache = other.sortedCache;
+            sortedCacheVersion = other.sortedCacheVersion;
+            generatedCache = other.generatedCache;
+            projectedCache = other.projectedCache;
+            return *this;
+        }
+
         /**
          * @param value Element to add to the container
          * @return None
          * @throws None
          */
         void addElement(const T& value) {  // Add an element to the container
-            data.push_back(value);  // Append value to data vector
+            mutableData().push_back(value);  // Append value to data vector
             version++; // Update version on modification
         }
 
@@ -46,12 +172,35 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
          * @throws std::runtime_error If element is not found
          */
         void removeElement(const T& value) {  // Remove an element from the container
-            auto it = std::remove(data.begin(), data.end(), value);  // Move matching elements to end
-            if (it == data.end()) {  // Check if no elements were found
+            std::vector<T>& values = mutableData();  // Unshare before compacting
+            if (!sortedCache) {  // Nothing cached to keep in sync
+                auto it = std::remove(values.begin(), values.end(), value);  // Move matching elements to end
+                if (it == values.end()) {  // Check if no elements were found
+                    throw std::runtime_error("Element not found in container.");  // Throw exception if not found
+                }
+                values.erase(it, values.end());  // Erase removed elements from vector
+                version++;  // Update version on modification
+                return;
+            }
+
+            std::vector<size_t> newPosition(values.size());  // Old index -> new index, or REMOVED
+            size_t kept = 0;  // Number of surviving elements so far
+            for (size_t i = 0; i < values.size(); ++i) {  // Compact data and record where each element went
+                if (values[i] == value) {
+                    newPosition[i] = SortedPermutation<T>::REMOVED;  // Element is dropped
+                } else {
+                    if (kept != i) {
+                        values[kept] = std::move(values[i]);  // Shift survivor down
+                    }
+                    newPosition[i] = kept++;  // Survivor's new index
+                }
+            }
+            if (kept == values.size()) {  // Check if no elements were found
                 throw std::runtime_error("Element not found in container.");  // Throw exception if not found
             }
-            data.erase(it, data.end());  // Erase removed elements from vector
+            values.erase(values.begin() + kept, values.end());  // Erase removed elements from vector
             version++;  // Update version on modification
+            sortedCache = std::make_shared<const SortedPermutation<T>>(*sortedCache, newPosition);  // Patch cached order instead of resorting
         }
 
         /**
@@ -59,7 +208,7 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
          * @throws None
          */
         size_t size() const {  // Return the number of elements
-            return data.size();  // Return size of data vector
+            return data->size();  // Return size of data vector
         }
 
         /**
@@ -67,7 +216,7 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
          * @throws None
          */
         const std::vector<T>& getData() const {  // Get container data
-            return data;  // Return reference to data vector
+            return *data;  // Return reference to data vector
         }
 
         /**
@@ -78,6 +227,265 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
             return version;          // Used for iterator consistency check
         }
 
+        /**
+         * @param mode Eager sorts the whole container when a sorted iterator is first requested;
+         *             Lazy sorts only as far as iterators actually read
+         * @return None
+         * @throws None
+         */
+        void setSortMode(SortMode mode) {  // Select how sorted permutations are built
+            sortMode = mode;  // Applies to the next permutation built; the current one stays valid
+        }
+
+        /**
+         * @return Mode used to build sorted permutations
+         * @throws None
+         */
+        SortMode getSortMode() const {  // Return current sort mode
+            return sortMode;
+        }
+
+        /**
+         * @param mode Checked (the default) or Snapshot; applies to iterators created afterwards
+         * @return None
+         * @throws None
+         */
+        void setIterationMode(IterationMode mode) {  // Select iterator behavior under modification
+            iterationMode = mode;
+        }
+
+        /**
+         * @return Mode applied to new iterators
+         * @throws None
+         */
+        IterationMode getIterationMode() const {  // Return current iteration mode
+            return iterationMode;
+        }
+
+        /**
+         * @return Immutable snapshot of the current data for a new iterator to pin, or nullptr in checked mode
+         * @throws None
+         */
+        // The snapshot stays alive (and unchanged) until its last iterator is destroyed; writers copy instead
+        std::shared_ptr<const std::vector<T>> pinData() const {  // Snapshot for iterators
+            if (iterationMode != IterationMode::Snapshot) {
+                return nullptr;  // Iterators read the live data
+            }
+            dataShared.set.store(true);  // The next write must not touch this vector
+            return data;  // O(1): shares the current vector
+        }
+
+        /**
+         * @return Shared ascending permutation of the data, valid for the current version
+         * @throws None
+         */
+        // Shared by the ascending, descending and side-cross iterators; rebuilt only after a modification
+        std::shared_ptr<const SortedPermutation<T>> getSortedPermutation() const {  // Get cached ascending permutation
+            std::lock_guard<std::mutex> lock(cacheMutex);  // Concurrent first readers build it once
+            if (!sortedCache || sortedCacheVersion != version) {  // Cache missing or stale
+                if (!sortedCache) {  // Nothing to build on
+                    sortedCache = std::make_shared<const SortedPermutation<T>>(*data, sortMode);  // Fresh buffer
+                } else if (sortedCache->size() < data->size()) {  // Elements were appended since the last build
+                    if (sortMode == SortMode::Eager || sortedCache->isComplete()) {  // Cached prefix can be extended
+                        sortedCache = std::make_shared<const SortedPermutation<T>>(sortedCache->mergeAppended(*data));  // Merge the new tail
+                    } else {
+                        sortedCache = std::make_shared<const SortedPermutation<T>>(*data, sortMode);  // Partial lazy order: start over lazily
+                    }
+                }  // Otherwise removeElement already patched the cache to cover all of data
+                sortedCacheVersion = version;  // Tag cache with the version it describes
+            }
+            return sortedCache;  // Return cached permutation
+        }
+
+        /**
+         * @return Data indices in Policy's order, generated at most once per version
+         * @throws std::length_error If Policy::generate does not return exactly one index per element
+         */
+        // Cached per (policy, version) like the ascending permutation; shared with every iterator of that order
+        template<typename Policy>
+        std::shared_ptr<const std::vector<size_t>> getGeneratedPermutation() const {  // Get cached custom permutation
+            std::lock_guard<std::mutex> lock(cacheMutex);  // operator[] inserts; concurrent first readers generate once
+            CachedPermutation& cached = generatedCache[std::type_index(typeid(Policy))];
+            if (!cached.indices || cached.version != version) {  // Cache missing or stale
+                auto indices = std::make_shared<const std::vector<size_t>>(Policy::generate(*data));  // Run the policy once
+                if (indices->size() != data->size()) {
+                    throw std::length_error("Order policy must generate one index per element.");
+                }
+                cached.indices = indices;
+                cached.version = version;  // Tag cache with the version it describes
+            }
+            return cached.indices;
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys
+         * @param proj Projection: a callable or a pointer to a data member
+         * @return Permutation ascending by comp on proj(element), ties by insertion order
+         * @throws Whatever comp or proj throws
+         */
+        // Stateless comparators and projections (empty types) are cached per (types, version); anything with
+        // state (function pointers, capturing lambdas) could differ between calls, so it is sorted on every call
+        template<typename Compare, typename Projection>
+        std::shared_ptr<const SortedPermutation<T>> getProjectedPermutation(Compare comp, Projection proj) const {
+            bool cacheable = std::is_empty<Compare>::value && std::is_empty<Projection>::value;  // Type identifies behaviour
+            CachedProjection* cached = nullptr;
+            std::unique_lock<std::mutex> lock(cacheMutex, std::defer_lock);  // Uncached sorts touch no shared state
+            if (cacheable) {
+                lock.lock();  // operator[] inserts; concurrent first readers sort once
+                cached = &projectedCache[std::type_index(typeid(ProjectionKey<Compare, Projection>))];
+                if (cached->permutation && cached->version == version) {
+                    return cached->permutation;  // Already sorted for this version
+                }
+            }
+            std::vector<size_t> descending;  // Equal keys by insertion order, like the built-in descending order
+            std::vector<size_t> ascending = sortIndicesBy(*data, comp, proj, &descending);  // Keys projected once each
+            auto permutation = std::make_shared<const SortedPermutation<T>>(std::move(ascending), std::move(descending));
+            if (cached) {
+                cached->permutation = permutation;
+                cached->version = version;  // Tag cache with the version it describes
+            }
+            return permutation;
+        }
+
+        /**
+         * @return Indices into the data vector in ascending order of their values (ties by insertion order)
+         * @throws None
+         */
+        const std::vector<size_t>& getSortedIndices() const {  // Get the fully sorted permutation
+            return getSortedPermutation()->sortedIndices(*data);  // Completes a lazy permutation if needed
+        }
+
+        /**
+         * @return Indices into the data vector in descending order of their values (ties by insertion order)
+         * @throws None
+         */
+        const std::vector<size_t>& getDescendingIndices() const {  // Get the fully sorted descending permutation
+            return getSortedPermutation()->descendingIndices(*data);  // Built once per version from the ascending one
+        }
+
+    private:
+        /**
+         * @param position Position in the policy's order
+         * @param n Number of elements
+         * @param sorted Complete permutation the policy's ranks refer to, or nullptr for unsorted policies
+         * @return Data index visited at that position
+         * @throws None
+         */
+        template<typename Policy>
+        static size_t indexAt(size_t position, size_t n, const std::vector<size_t>* sorted) {  // Apply one order policy
+            size_t mapped = Policy::map(position, n);  // Rank or data index
+            return Policy::sorted ? (*sorted)[mapped] : mapped;
+        }
+
+        /**
+         * @param order Traversal order
+         * @param position Position in that order, must be less than size()
+         * @param sorted Complete descending permutation for Order::Descending, ascending for the other
+         *        sorted orders (unused for unsorted orders)
+         * @return Index into data of the element visited at that position
+         * @throws None
+         */
+        // Same order policies the iterators use, so parallel traversal visits exactly what the serial loop visits
+        size_t indexAt(Order order, size_t position, const std::vector<size_t>* sorted) const {  // Map position to data index
+            size_t n = data->size();  // Number of elements
+            switch (order) {
+                case Order::Ascending:
+                    return indexAt<AscendingOrder>(position, n, sorted);
+                case Order::Descending:
+                    return indexAt<DescendingOrder>(position, n, sorted);
+                case Order::SideCross:
+                    return indexAt<SideCrossOrder>(position, n, sorted);
+                case Order::Reverse:
+                    return indexAt<ReverseOrder>(position, n, sorted);
+                case Order::MiddleOut:
+                    return indexAt<MiddleOutOrder>(position, n, sorted);
+                default:
+                    return indexAt<InsertionOrder>(position, n, sorted);
+            }
+        }
+
+        /**
+         * @param order Traversal order
+         * @param body Callable invoked as body(chunk, lo, hi, sorted) for each chunk of positions
+         * @param scheduler Scheduler to run on
+         * @return Number of chunks used
+         * @throws std::runtime_error If the container is modified during traversal
+         */
+        // Splits the position range into chunks; the version is checked once per chunk, not per element
+        template<typename Body>
+        size_t forEachChunk(Order order, Body body, TaskScheduler& scheduler) const {  // Shared driver for parallel traversal
+            const std::vector<size_t>* sorted = nullptr;  // Permutation, if the order needs one
+            if (order == Order::Descending) {
+                sorted = &getDescendingIndices();  // DescendingOrder ranks refer to it
+            } else if (order == Order::Ascending || order == Order::SideCross) {
+                sorted = &getSortedIndices();  // Complete it up front so workers never wait on the refinement lock
+            }
+            size_t n = data->size();  // Number of positions
+            size_t chunks = scheduler.size() > 1 ? std::min(n, 4 * scheduler.size()) : std::min<size_t>(n, 1);  // A few chunks per worker for balance
+            size_t capturedVersion = version;  // Version the traversal started at
+            parallelFor(0, chunks, chunks, [&](size_t first, size_t last) {
+                for (size_t chunk = first; chunk < last; ++chunk) {
+                    if (capturedVersion != version) {  // Ensure container was not modified since traversal started
+                        throw std::runtime_error("Container modified during iteration");
+                    }
+                    body(chunk, n * chunk / chunks, n * (chunk + 1) / chunks, sorted);  // Even split of positions
+                }
+            }, scheduler);
+            return chunks;
+        }
+
+    public:
+        /**
+         * @param order Traversal order
+         * @param fn Callable invoked as fn(const T&) once per element; may run concurrently on several threads
+         * @param scheduler Scheduler to run on; defaults to the global one
+         * @return None
+         * @throws std::runtime_error If the container is modified during traversal
+         * @throws Any exception thrown by fn
+         */
+        template<typename F>
+        void parallel_for_each(Order order, F fn, TaskScheduler& scheduler = TaskScheduler::global()) const {  // Visit every element in parallel
+            forEachChunk(order, [&](size_t, size_t lo, size_t hi, const std::vector<size_t>* sorted) {
+                for (size_t position = lo; position < hi; ++position) {
+                    fn((*data)[indexAt(order, position, sorted)]);  // Elements of a chunk are visited in order
+                }
+            }, scheduler);
+        }
+
+        /**
+         * @param order Traversal order
+         * @param init Initial value of the reduction
+         * @param reduce Associative callable combining two results
+         * @param transform Callable mapping an element to a result
+         * @param scheduler Scheduler to run on; defaults to the global one
+         * @return init combined with transform(x) of every element, in traversal order
+         * @throws std::runtime_error If the container is modified during traversal
+         * @throws Any exception thrown by reduce or transform
+         */
+        // Each chunk reduces its positions in order; partial results are then combined in chunk order,
+        // so the result matches a serial fold whenever reduce is associative
+        template<typename U, typename Reduce, typename Transform>
+        U parallel_transform_reduce(Order order, U init, Reduce reduce, Transform transform,
+                                    TaskScheduler& scheduler = TaskScheduler::global()) const {  // Map and fold in parallel
+            std::vector<U> partials;  // One result per chunk
+            size_t slots = std::max<size_t>(1, std::min(data->size(), 4 * scheduler.size()));  // Upper bound on chunks
+            partials.reserve(slots);
+            for (size_t i = 0; i < slots; ++i) {
+                partials.push_back(init);  // Placeholder, overwritten by each chunk
+            }
+            size_t chunks = forEachChunk(order, [&](size_t chunk, size_t lo, size_t hi, const std::vector<size_t>* sorted) {
+                U partial = transform((*data)[indexAt(order, lo, sorted)]);  // Chunks are never empty
+                for (size_t position = lo + 1; position < hi; ++position) {
+                    partial = reduce(partial, transform((*data)[indexAt(order, position, sorted)]));
+                }
+                partials[chunk] = partial;
+            }, scheduler);
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                init = reduce(init, partials[chunk]);  // Combine in traversal order
+            }
+            return init;
+        }
+
 
         /**
          * @param os Output stream to write to
@@ -88,9 +496,9 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
         // Print all elements
         friend std::ostream& operator<<(std::ostream& os, const MyContainer<T>& container) {  // Stream output operator
             os << "[";  // Print opening bracket
-            for (size_t i = 0; i < container.data.size(); ++i) {  // Iterate over elements
-                os << container.data[i];  // Print current element
-                if (i < container.data.size() - 1) {  // Check if not last element
+            for (size_t i = 0; i < container.data->size(); ++i) {  // Iterate over elements
+                os << (*container.data)[i];  // Print current element
+                if (i < container.data->size() - 1) {  // Check if not last element
                     os << ", ";  // Print comma and space
                 }
             }
@@ -194,6 +602,174 @@ namespace ariel { // Namespace ariel to encapsulate classes and functions
             return MiddleOutOrderIterator<T>(*this, true);  // Return new iterator at end
         }
 
+        /**
+         * @return View over ascending order; sorts at most once
+         * @throws None
+         */
+        OrderView<AscendingOrderIterator<T>> ascending() const {  // Range over ascending order
+            return OrderView<AscendingOrderIterator<T>>(begin_ascending_order(), end_ascending_order());
+        }
+
+        /**
+         * @return View over descending order; sorts at most once
+         * @throws None
+         */
+        OrderView<DescendingOrderIterator<T>> descending() const {  // Range over descending order
+            return OrderView<DescendingOrderIterator<T>>(begin_descending_order(), end_descending_order());
+        }
+
+        /**
+         * @return View over side-cross order; sorts at most once
+         * @throws None
+         */
+        OrderView<SideCrossOrderIterator<T>> side_cross() const {  // Range over side-cross order
+            return OrderView<SideCrossOrderIterator<T>>(begin_side_cross_order(), end_side_cross_order());
+        }
+
+        /**
+         * @return View over reverse order
+         * @throws None
+         */
+        OrderView<ReverseOrderIterator<T>> reverse() const {  // Range over reverse order
+            return OrderView<ReverseOrderIterator<T>>(begin_reverse_order(), end_reverse_order());
+        }
+
+        /**
+         * @return View over insertion order
+         * @throws None
+         */
+        OrderView<OrderIterator<T>> order() const {  // Range over insertion order
+            return OrderView<OrderIterator<T>>(begin_order(), end_order());
+        }
+
+        /**
+         * @return View over middle-out order
+         * @throws None
+         */
+        OrderView<MiddleOutOrderIterator<T>> middle_out() const {  // Range over middle-out order
+            return OrderView<MiddleOutOrderIterator<T>>(begin_middle_out_order(), end_middle_out_order());
+        }
+
+        /**
+         * @return Iterator to the beginning of Policy's order (see OrderedIterator for the policy interface)
+         * @throws std::length_error If a generating policy returns the wrong number of indices
+         */
+        template<typename Policy>
+        OrderedIterator<T, Policy> begin_custom_order() const {  // Begin iterator for a user-defined order
+            return OrderedIterator<T, Policy>(*this, false);  // Return new iterator at start
+        }
+
+        /**
+         * @return Iterator to the end of Policy's order
+         * @throws None
+         */
+        template<typename Policy>
+        OrderedIterator<T, Policy> end_custom_order() const {  // End iterator for a user-defined order
+            return OrderedIterator<T, Policy>(*this, true);  // Return new iterator at end
+        }
+
+        /**
+         * @return View over Policy's order; a generating policy runs at most once per version
+         * @throws std::length_error If a generating policy returns the wrong number of indices
+         */
+        template<typename Policy>
+        OrderView<OrderedIterator<T, Policy>> custom_order() const {  // Range over a user-defined order
+            return OrderView<OrderedIterator<T, Policy>>(begin_custom_order<Policy>(), end_custom_order<Policy>());
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys, e.g. std::greater<>()
+         * @param proj Projection: a callable or a pointer to a data member, e.g. &Point::x; identity by default
+         * @return Iterator to the beginning of ascending order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        AscendingOrderIterator<T> begin_ascending_order(Compare comp, Projection proj = Projection()) const {  // Begin iterator for a custom ascending order
+            return AscendingOrderIterator<T>(*this, getProjectedPermutation(comp, proj));  // Reads the projected permutation
+        }
+
+        /**
+         * @return Iterator to the end of ascending order by comp on proj(element)
+         * @throws None
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        AscendingOrderIterator<T> end_ascending_order(Compare, Projection = Projection()) const {  // End iterator for a custom ascending order
+            return end_ascending_order();  // Same end position as the default order
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys
+         * @param proj Projection: a callable or a pointer to a data member; identity by default
+         * @return View over ascending order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        OrderView<AscendingOrderIterator<T>> ascending(Compare comp, Projection proj = Projection()) const {  // Range over a custom ascending order
+            return OrderView<AscendingOrderIterator<T>>(begin_ascending_order(comp, proj), end_ascending_order());
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys, e.g. std::greater<>()
+         * @param proj Projection: a callable or a pointer to a data member, e.g. &Point::x; identity by default
+         * @return Iterator to the beginning of descending order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        DescendingOrderIterator<T> begin_descending_order(Compare comp, Projection proj = Projection()) const {  // Begin iterator for a custom descending order
+            return DescendingOrderIterator<T>(*this, getProjectedPermutation(comp, proj));  // Reads the projected permutation
+        }
+
+        /**
+         * @return Iterator to the end of descending order by comp on proj(element)
+         * @throws None
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        DescendingOrderIterator<T> end_descending_order(Compare, Projection = Projection()) const {  // End iterator for a custom descending order
+            return end_descending_order();  // Same end position as the default order
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys
+         * @param proj Projection: a callable or a pointer to a data member; identity by default
+         * @return View over descending order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        OrderView<DescendingOrderIterator<T>> descending(Compare comp, Projection proj = Projection()) const {  // Range over a custom descending order
+            return OrderView<DescendingOrderIterator<T>>(begin_descending_order(comp, proj), end_descending_order());
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys, e.g. std::greater<>()
+         * @param proj Projection: a callable or a pointer to a data member, e.g. &Point::x; identity by default
+         * @return Iterator to the beginning of side-cross order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        SideCrossOrderIterator<T> begin_side_cross_order(Compare comp, Projection proj = Projection()) const {  // Begin iterator for a custom side-cross order
+            return SideCrossOrderIterator<T>(*this, getProjectedPermutation(comp, proj));  // Reads the projected permutation
+        }
+
+        /**
+         * @return Iterator to the end of side-cross order by comp on proj(element)
+         * @throws None
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        SideCrossOrderIterator<T> end_side_cross_order(Compare, Projection = Projection()) const {  // End iterator for a custom side-cross order
+            return end_side_cross_order();  // Same end position as the default order
+        }
+
+        /**
+         * @param comp Strict weak order on projected keys
+         * @param proj Projection: a callable or a pointer to a data member; identity by default
+         * @return View over side-cross order by comp on proj(element)
+         * @throws Whatever comp or proj throws
+         */
+        template<typename Compare, typename Projection = IdentityProjection>
+        OrderView<SideCrossOrderIterator<T>> side_cross(Compare comp, Projection proj = Projection()) const {  // Range over a custom side-cross order
+            return OrderView<SideCrossOrderIterator<T>>(begin_side_cross_order(comp, proj), end_side_cross_order());
+        }
+
     };
 
 } // Namespace ariel
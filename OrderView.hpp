@@ -0,0 +1,87 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef ORDERVIEW_HPP  // Header guard to prevent multiple inclusions of this file
+#define ORDERVIEW_HPP
+
+#include <cstddef>     // Include cstddef header for size_t
+#include <iterator>    // Include iterator header for std::iterator_traits and std::distance
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Begin/end pair for one traversal order, usable in range-for and STL algorithms.
+     *
+     * Built once from begin_*() and end_*(): the begin iterator already holds the shared permutation,
+     * and begin() hands out copies of it, so iterating a view (any number of times) never sorts again.
+     * Copying a view copies two iterators, i.e. a few pointers. Like its iterators, a view is
+     * invalidated by modifying the container unless the container is in snapshot mode.
+     */
+    template<typename Iterator> // Template class definition for OrderView
+    class OrderView {
+    private:
+        Iterator first;  // Iterator to the first element
+        Iterator last;   // Past-the-end iterator
+
+    public:
+        typedef Iterator iterator;                                                // Iterator type
+        typedef Iterator const_iterator;                                          // Views are read-only
+        typedef typename std::iterator_traits<Iterator>::value_type value_type;  // Element type
+        typedef typename std::iterator_traits<Iterator>::reference reference;    // Result of dereferencing
+        typedef typename std::iterator_traits<Iterator>::difference_type difference_type;  // Signed distance
+
+        /**
+         * @param begin Iterator to the first element
+         * @param end Past-the-end iterator of the same order
+         * @throws None
+         */
+        OrderView(Iterator begin, Iterator end)  // Constructor for view
+            : first(begin), last(end) {}
+
+        /**
+         * @return Iterator to the first element
+         * @throws None
+         */
+        Iterator begin() const {
+            return first;
+        }
+
+        /**
+         * @return Past-the-end iterator
+         * @throws None
+         */
+        Iterator end() const {
+            return last;
+        }
+
+        /**
+         * @return True if the view has no elements
+         * @throws None
+         */
+        bool empty() const {
+            return first == last;
+        }
+
+        /**
+         * @return Number of elements; O(1) for random-access iterators
+         * @throws None
+         */
+        size_t size() const {
+            return static_cast<size_t>(std::distance(first, last));
+        }
+
+        /**
+         * @param n Position in the view, must be less than size()
+         * @return Element at that position; random-access iterators only
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If n is out of range
+         */
+        reference operator[](difference_type n) const {
+            return first[n];
+        }
+    };
+
+} // Namespace ariel
+
+#endif //ORDERVIEW_HPP  // Header guard
@@ -0,0 +1,417 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef ORDEREDITERATOR_HPP  // Header guard to prevent multiple inclusions of this file
+#define ORDEREDITERATOR_HPP
+
+#include <vector>      // Include vector header for vector operations
+#include <cstddef>     // Include cstddef header for size_t and std::ptrdiff_t
+#include <memory>      // Include memory header for std::shared_ptr
+#include <iterator>    // Include iterator header for std::random_access_iterator_tag
+#include <stdexcept>   // Include stdexcept for exceptions
+#include <type_traits> // Include type_traits header for detecting generating policies
+#include <utility>     // Include utility header for std::declval
+#include "IteratorChecks.hpp"  // Include header for the checked / unchecked iterator policy
+#include "SortedPermutation.hpp"  // Include header for SortedPermutation
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    template<typename T>
+    class MyContainer;  // Forward declaration of MyContainer class template
+
+    /**
+     * @brief True if OrderPolicy generates its permutation, i.e. has a static generate(const std::vector<T>&).
+     */
+    template<typename OrderPolicy, typename T, typename = void>
+    struct GeneratesPermutation : std::false_type {};
+
+    template<typename OrderPolicy, typename T>
+    struct GeneratesPermutation<OrderPolicy, T,
+        decltype(static_cast<void>(OrderPolicy::generate(std::declval<const std::vector<T>&>())))> : std::true_type {};
+
+    /**
+     * @brief True if OrderPolicy declares static const bool descending = true, i.e. its map() returns
+     * ranks in the descending permutation (equal values by insertion order) rather than the ascending one.
+     */
+    template<typename OrderPolicy, typename = void>
+    struct ReadsDescendingRanks : std::false_type {};
+
+    template<typename OrderPolicy>
+    struct ReadsDescendingRanks<OrderPolicy, typename std::enable_if<OrderPolicy::descending>::type> : std::true_type {};
+
+    /**
+     * @brief Random-access iterator over one traversal order of a MyContainer.
+     *
+     * All traversal logic except the position mapping is shared here; OrderPolicy supplies the mapping
+     * at compile time, so it is inlined into the loop. A policy provides either a closed form:
+     *   - static const bool sorted: true if map() returns a rank in the container's ascending
+     *     permutation, false if it returns a data index directly;
+     *   - static size_t map(size_t position, size_t n): the rank or data index visited at position
+     *     (0 <= position < n) of a container holding n elements;
+     *   - optionally static const bool descending = true: map() returns ranks in the descending
+     *     permutation instead (DescendingOrder);
+     * or a generated permutation:
+     *   - static std::vector<size_t> generate(const std::vector<T>& data): every data index exactly
+     *     once, in traversal order. The container caches the result per (policy, version), so it runs
+     *     once after each modification no matter how many iterators are built.
+     * The six built-in orders are the policies next to their iterator aliases (AscendingOrderIterator.hpp, ...).
+     */
+    template<typename T, typename OrderPolicy> // Template class definition for OrderedIterator
+    class OrderedIterator {
+    private:
+        const MyContainer<T>* container;              // Pointer to the MyContainer instance
+        std::shared_ptr<const SortedPermutation<T>> sorted_indices;  // Ascending permutation shared with the container's cache; sorted policies only
+        std::shared_ptr<const std::vector<size_t>> generated;  // Permutation shared with the container's cache; generating policies only
+        size_t index;                                 // Current position in the order
+        size_t capturedVersion;                       // Version of the container at iterator creation
+        std::shared_ptr<const std::vector<T>> snapshot;  // Data pinned in snapshot mode; null in checked mode
+
+        /**
+         * @return Data the iterator reads: its pinned snapshot, or the live container data
+         * @throws None
+         */
+        const std::vector<T>& values() const {  // Select snapshot or live data
+            return snapshot ? *snapshot : container->getData();
+        }
+
+        typedef std::integral_constant<bool, GeneratesPermutation<OrderPolicy, T>::value> Generated;  // Selects the overloads below
+        typedef std::integral_constant<bool, ReadsDescendingRanks<OrderPolicy>::value> Descending;  // Selects rankIndex below
+
+        /**
+         * @return None
+         * @throws std::length_error If the policy returns the wrong number of indices
+         */
+        void acquireOrder(std::true_type) {  // Generating policy
+            generated = container->template getGeneratedPermutation<OrderPolicy>();  // Generates only if stale
+        }
+
+        /**
+         * @return None
+         * @throws None
+         */
+        void acquireOrder(std::false_type) {  // Closed-form policy
+            if (OrderPolicy::sorted) {  // Resolved at compile time
+                sorted_indices = container->getSortedPermutation();  // Share cached permutation; sorts only if stale
+            }
+        }
+
+        /**
+         * @param data Data the iterator reads
+         * @return Index into data of the current position
+         * @throws None
+         */
+        size_t dataIndex(const std::vector<T>&, std::true_type) const {  // Generating policy
+            return (*generated)[index];
+        }
+
+        /**
+         * @param data Data the iterator reads
+         * @return Index into data of the current position
+         * @throws None
+         */
+        size_t dataIndex(const std::vector<T>& data, std::false_type) const {  // Closed-form policy
+            size_t mapped = OrderPolicy::map(index, data.size());  // Rank or data index at this position
+            return OrderPolicy::sorted ? rankIndex(mapped, data, Descending()) : mapped;
+        }
+
+        /**
+         * @param rank Rank in the descending permutation
+         * @param data Data the iterator reads
+         * @return Index into data of that rank
+         * @throws None
+         */
+        size_t rankIndex(size_t rank, const std::vector<T>& data, std::true_type) const {  // Descending ranks
+            return sorted_indices->indexAtDescendingRank(rank, data);
+        }
+
+        /**
+         * @param rank Rank in the ascending permutation
+         * @param data Data the iterator reads
+         * @return Index into data of that rank
+         * @throws None
+         */
+        size_t rankIndex(size_t rank, const std::vector<T>& data, std::false_type) const {  // Ascending ranks
+            return sorted_indices->indexAtRank(rank, data);
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return True if both iterators read the same data vector (always, unless a snapshot is involved)
+         * @throws None
+         */
+        bool sameData(const OrderedIterator& other) const {
+            return container == nullptr || &values() == &other.values();  // Singular iterators have no data
+        }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;  // O(1) jumps and differences
+        typedef T value_type;                                        // Element type
+        typedef std::ptrdiff_t difference_type;                      // Signed distance between positions
+        typedef const T* pointer;                                    // Result of operator->
+        typedef const T& reference;                                  // Result of operator*
+        typedef OrderPolicy policy_type;                             // Position-to-index mapping
+
+        /**
+         * @throws None
+         */
+        OrderedIterator() : container(nullptr), index(0), capturedVersion(0) {}  // Singular iterator; may only be assigned to
+
+        /**
+         * @param cont Reference to the MyContainer to iterate over
+         * @param is_end If true, initializes iterator to end position; default is false
+         * @throws std::length_error If a generating policy returns the wrong number of indices
+         */
+        // Regular constructor
+        OrderedIterator(const MyContainer<T>& cont, bool is_end = false)  // Constructor for iterator
+            : container(&cont), index(0) {  // Initialize container pointer and index to 0
+            capturedVersion = container->getVersion();  // Capture version at construction
+            snapshot = container->pinData();  // Pin the current data when snapshot iteration is enabled
+
+            if (is_end) {  // End iterator only needs the size, so skip building the order
+                index = values().size();  // Past-the-end position
+                return;  // O(1) construction without sorting
+            }
+
+            acquireOrder(Generated());  // Permutation, if the policy needs one
+        }
+
+        /**
+         * @param cont Reference to the MyContainer to iterate over
+         * @param permutation Complete ascending permutation of cont's current data, read instead of the container's own
+         * @throws None
+         */
+        // Sorted policies only; used for comparator / projection orders
+        OrderedIterator(const MyContainer<T>& cont, std::shared_ptr<const SortedPermutation<T>> permutation)
+            : container(&cont), sorted_indices(std::move(permutation)), index(0) {
+            static_assert(OrderPolicy::sorted, "Only sorted order policies read an ascending permutation");
+            capturedVersion = container->getVersion();  // Capture version at construction
+            snapshot = container->pinData();  // Pin the current data when snapshot iteration is enabled
+        }
+
+        /**
+         * @return Reference to the current element, valid until the container is modified (snapshot iterators: while any copy of the iterator lives)
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        // Dereference operator to access current element
+        const T& operator*() const ARIEL_ITERATOR_NOEXCEPT {  // Return current element
+            ARIEL_ITERATOR_CHECK(!snapshot && capturedVersion != container->getVersion(), std::runtime_error, "Container modified during iteration");  // Ensure container was not modified since iterator creation
+            const std::vector<T>& data = values();  // Get reference to container data
+            ARIEL_ITERATOR_CHECK(index >= data.size(), std::out_of_range, "Iterator out of range");  // Check if index is out of bounds
+            return data[dataIndex(data, Generated())];  // Mapping resolved at compile time
+        }
+
+        /**
+         * @return Pointer to the current element, valid until the container is modified (snapshot iterators: while any copy of the iterator lives)
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        const T* operator->() const ARIEL_ITERATOR_NOEXCEPT {  // Member access on the current element
+            return std::addressof(**this);  // Same checks as operator*
+        }
+
+        /**
+         * @return Reference to incremented iterator
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        // Prefix increment operator
+        OrderedIterator& operator++() ARIEL_ITERATOR_NOEXCEPT {  // Increment iterator (prefix)
+            ARIEL_ITERATOR_CHECK(!snapshot && capturedVersion != container->getVersion(), std::runtime_error, "Container modified during iteration");  // Ensure container was not modified since iterator creation
+            ARIEL_ITERATOR_CHECK(index >= values().size(), std::out_of_range, "Cannot increment beyond end.");  // Check if increment would go beyond end
+            ++index;  // Increment index
+            return *this;  // Return reference to self
+        }
+
+        /**
+         * @return Copy of iterator before increment
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        // Postfix increment operator
+        OrderedIterator operator++(int) ARIEL_ITERATOR_NOEXCEPT {  // Increment iterator (postfix)
+            OrderedIterator temp = *this;  // Save current iterator state (copies pointers, not the indices)
+            ++(*this);                     // Increment self using prefix ++
+            return temp;                   // Return copy before increment
+        }
+
+        /**
+         * @return Reference to decremented iterator
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at the beginning
+         */
+        // Prefix decrement operator
+        OrderedIterator& operator--() ARIEL_ITERATOR_NOEXCEPT {  // Decrement iterator (prefix)
+            ARIEL_ITERATOR_CHECK(!snapshot && capturedVersion != container->getVersion(), std::runtime_error, "Container modified during iteration");  // Ensure container was not modified since iterator creation
+            ARIEL_ITERATOR_CHECK(index == 0, std::out_of_range, "Cannot decrement before begin.");  // Check if decrement would go before begin
+            --index;  // Decrement index
+            return *this;  // Return reference to self
+        }
+
+        /**
+         * @return Copy of iterator before decrement
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at the beginning
+         */
+        // Postfix decrement operator
+        OrderedIterator operator--(int) ARIEL_ITERATOR_NOEXCEPT {  // Decrement iterator (postfix)
+            OrderedIterator temp = *this;  // Save current iterator state
+            --(*this);                     // Decrement self using prefix --
+            return temp;                   // Return copy before decrement
+        }
+
+        /**
+         * @param n Number of positions to move, may be negative
+         * @return Reference to moved iterator
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the new position is outside [begin, end]
+         */
+        OrderedIterator& operator+=(difference_type n) ARIEL_ITERATOR_NOEXCEPT {  // Jump in O(1)
+            ARIEL_ITERATOR_CHECK(!snapshot && capturedVersion != container->getVersion(), std::runtime_error, "Container modified during iteration");  // Ensure container was not modified since iterator creation
+            ARIEL_ITERATOR_CHECK(n < 0 ? static_cast<size_t>(-n) > index : static_cast<size_t>(n) > values().size() - index,
+                                 std::out_of_range, "Iterator moved out of range");  // Check the target stays within [begin, end]
+            index += static_cast<size_t>(n);  // Unsigned wrap-around makes negative steps work
+            return *this;  // Return reference to self
+        }
+
+        /**
+         * @param n Number of positions to move back, may be negative
+         * @return Reference to moved iterator
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the new position is outside [begin, end]
+         */
+        OrderedIterator& operator-=(difference_type n) ARIEL_ITERATOR_NOEXCEPT {  // Jump back in O(1)
+            return *this += -n;
+        }
+
+        /**
+         * @param n Number of positions to move, may be negative
+         * @return Iterator n positions further
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the new position is outside [begin, end]
+         */
+        OrderedIterator operator+(difference_type n) const ARIEL_ITERATOR_NOEXCEPT {
+            OrderedIterator moved = *this;  // Copies pointers only
+            return moved += n;
+        }
+
+        /**
+         * @param n Number of positions to move, may be negative
+         * @param it Iterator to move
+         * @return Iterator n positions further
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the new position is outside [begin, end]
+         */
+        friend OrderedIterator operator+(difference_type n, const OrderedIterator& it) ARIEL_ITERATOR_NOEXCEPT {
+            return it + n;
+        }
+
+        /**
+         * @param n Number of positions to move back, may be negative
+         * @return Iterator n positions earlier
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the new position is outside [begin, end]
+         */
+        OrderedIterator operator-(difference_type n) const ARIEL_ITERATOR_NOEXCEPT {
+            OrderedIterator moved = *this;  // Copies pointers only
+            return moved -= n;
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return Number of positions from other to this iterator
+         * @throws None
+         */
+        // Iterators over different data (a snapshot and a later version) only share their end position: an
+        // end iterator counts as the end of the other iterator's data, matching operator==
+        difference_type operator-(const OrderedIterator& other) const {  // Distance in O(1)
+            if (sameData(other)) {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+            bool atEnd = index >= values().size();
+            bool otherAtEnd = other.index >= other.values().size();
+            if (atEnd && otherAtEnd) {
+                return 0;
+            }
+            if (atEnd) {
+                return static_cast<difference_type>(other.values().size() - other.index);  // Rest of other's data
+            }
+            if (otherAtEnd) {
+                return -static_cast<difference_type>(values().size() - index);  // Rest of this iterator's data
+            }
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);  // No common sequence
+        }
+
+        /**
+         * @param n Offset from this iterator
+         * @return Reference to the element n positions further
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If the position is outside [begin, end)
+         */
+        reference operator[](difference_type n) const ARIEL_ITERATOR_NOEXCEPT {  // Random access in O(1)
+            return *(*this + n);
+        }
+
+        /**
+         * @brief Equality comparison operator.
+         * @param other Another iterator to compare.
+         * @return True if both iterators are at the same position and container.
+         */
+        bool operator==(const OrderedIterator& other) const {  // Compare iterators for equality
+            if (container != other.container) {
+                return false;
+            }
+            if (sameData(other)) {
+                return index == other.index;  // Same sequence: same position
+            }
+            // A snapshot ends where its pinned data ends, so it matches an end iterator built after later
+            // appends or removals; positions inside different data never match
+            return index >= values().size() && other.index >= other.values().size();
+        }
+
+        /**
+         * @brief Inequality comparison operator.
+         * @param other Another iterator to compare.
+         * @return True if iterators are at different positions or containers.
+         */
+        bool operator!=(const OrderedIterator& other) const {  // Compare iterators for inequality
+            return !(*this == other);  // Return negation of equality
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return True if this iterator is before other
+         */
+        bool operator<(const OrderedIterator& other) const {
+            return *this - other < 0;
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return True if this iterator is after other
+         */
+        bool operator>(const OrderedIterator& other) const {
+            return *this - other > 0;
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return True if this iterator is not after other
+         */
+        bool operator<=(const OrderedIterator& other) const {
+            return *this - other <= 0;
+        }
+
+        /**
+         * @param other Iterator over the same container
+         * @return True if this iterator is not before other
+         */
+        bool operator>=(const OrderedIterator& other) const {
+            return *this - other >= 0;
+        }
+    };
+
+} // Namespace ariel
+
+#endif //ORDEREDITERATOR_HPP  // Header guard
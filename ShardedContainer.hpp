@@ -0,0 +1,365 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef SHARDEDCONTAINER_HPP  // Header guard to prevent multiple inclusions of this file
+#define SHARDEDCONTAINER_HPP
+
+#include <vector>      // Include vector header for shard storage
+#include <memory>      // Include memory header for std::shared_ptr
+#include <utility>     // Include utility header for std::pair
+#include <algorithm>   // Include algorithm header for std::find
+#include <stdexcept>   // Include stdexcept header for std::runtime_error
+#include <iostream>    // Include iostream header for output streaming
+#include "MyContainer.hpp"           // Include header for the shards
+#include "TaskScheduler.hpp"         // Include header for sorting shards in parallel
+#include "ShardedOrderIterator.hpp"  // Include header for the merged iterators
+#include "OrderView.hpp"         // Include header for range views
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Container that spreads its elements round-robin over independent MyContainer shards.
+     *
+     * Each shard sorts its own permutation (all shards in parallel on the task scheduler); ordered
+     * iteration merges the shard permutations with a loser tree. Every element also records its global
+     * append sequence number, which breaks ties between shards and drives insertion and reverse order,
+     * so every order matches what a single MyContainer with the same history would produce.
+     */
+    template<typename T> // Template class definition for ShardedContainer
+    class ShardedContainer {
+    private:
+        std::vector<MyContainer<T>> shards;         // Independent shards
+        std::vector<std::vector<size_t>> sequence;  // sequence[s][i] = global append number of shards[s].getData()[i]
+        size_t nextSequence = 0;                    // Next global append number
+        size_t count = 0;                           // Total number of elements
+        size_t version = 0;                         // Tracks container version for iterator validation
+        mutable size_t sortedVersion = static_cast<size_t>(-1);  // Version every shard was last sorted at
+        mutable std::shared_ptr<const std::vector<std::pair<size_t, size_t>>> insertionCache;  // (shard, index) in insertion order
+        mutable size_t insertionCacheVersion = 0;   // Version insertionCache was built at
+
+        /**
+         * @return None
+         * @throws Any exception thrown while sorting
+         */
+        void sortShards() const {  // Bring every shard's permutation up to date, in parallel
+            if (sortedVersion == version) {
+                return;  // Nothing changed since the last sort
+            }
+            TaskGroup group;  // One task per shard; shards are separate objects
+            for (const MyContainer<T>& shard : shards) {
+                group.run([&shard] { shard.getSortedIndices(); });  // Sorts, merges or patches the shard's cache
+            }
+            group.wait();
+            sortedVersion = version;
+        }
+
+    public:
+        /**
+         * @param shardCount Number of shards; at least one is used
+         * @throws None
+         */
+        explicit ShardedContainer(size_t shardCount = TaskScheduler::global().size())  // Create empty shards
+            : shards(std::max<size_t>(1, shardCount)), sequence(shards.size()) {}
+
+        /**
+         * @param value Element to add to the container
+         * @return None
+         * @throws None
+         */
+        void addElement(const T& value) {  // Add an element to the next shard
+            size_t s = nextSequence % shards.size();  // Round-robin keeps shards balanced
+            shards[s].addElement(value);
+            sequence[s].push_back(nextSequence++);  // Remember the global position
+            ++count;
+            version++;  // Update version on modification
+        }
+
+        /**
+         * @param value Element to remove from the container
+         * @return None
+         * @throws std::runtime_error If element is not found
+         */
+        void removeElement(const T& value) {  // Remove every equal element from every shard
+            bool found = false;
+            for (size_t s = 0; s < shards.size(); ++s) {
+                const std::vector<T>& data = shards[s].getData();
+                if (std::find(data.begin(), data.end(), value) == data.end()) {
+                    continue;  // Shard unaffected
+                }
+                size_t kept = 0;  // Compact sequence numbers the same way removeElement compacts data
+                for (size_t i = 0; i < data.size(); ++i) {
+                    if (!(data[i] == value)) {
+                        sequence[s][kept++] = sequence[s][i];
+                    }
+                }
+                sequence[s].resize(kept);
+                count -= data.size() - kept;
+                shards[s].removeElement(value);  // Also patches the shard's cached permutation
+                found = true;
+            }
+            if (!found) {
+                throw std::runtime_error("Element not found in container.");  // Throw exception if not found
+            }
+            version++;  // Update version on modification
+        }
+
+        /**
+         * @return Number of elements in the container
+         * @throws None
+         */
+        size_t size() const {
+            return count;
+        }
+
+        /**
+         * @return Current version of the container.
+         * @throws None
+         */
+        size_t getVersion() const {
+            return version;
+        }
+
+        /**
+         * @return Number of shards
+         * @throws None
+         */
+        size_t shardCount() const {
+            return shards.size();
+        }
+
+        /**
+         * @param s Shard index, must be less than shardCount()
+         * @return The shard
+         * @throws None
+         */
+        const MyContainer<T>& getShard(size_t s) const {
+            return shards[s];
+        }
+
+        /**
+         * @param byValue True for value order, false for insertion order
+         * @param forward True for ascending / oldest first, false for descending / newest first
+         * @param stableDescending With byValue and !forward: equal values oldest first, as in MyContainer's
+         *        descending order, instead of the reversed ascending order that side-cross reads
+         * @return One merge cursor per shard
+         * @throws None
+         */
+        ShardRuns<T> runs(bool byValue, bool forward, bool stableDescending = false) const {  // Merge sources for the iterators
+            if (byValue) {
+                sortShards();  // Parallel across shards
+            }
+            if (stableDescending) {
+                ShardRuns<T> result = runs(true, true);  // Walk each shard's descending permutation forwards
+                result.largestFirst = true;
+                for (size_t s = 0; s < shards.size(); ++s) {
+                    result.shards[s].order = &shards[s].getDescendingIndices();  // Built once per shard version
+                    ShardRuns<T>::load(result.shards[s]);
+                }
+                return result;
+            }
+            ShardRuns<T> result;
+            result.byValue = byValue;
+            result.forward = forward;
+            result.largestFirst = !forward;
+            for (size_t s = 0; s < shards.size(); ++s) {
+                size_t n = shards[s].size();
+                typename ShardRuns<T>::Run run;
+                run.data = &shards[s].getData();
+                run.order = byValue ? &shards[s].getSortedIndices() : nullptr;  // Already sorted above
+                run.sequence = &sequence[s];
+                run.position = forward ? 0 : n - 1;  // Backward runs start at the last position
+                run.left = n;
+                ShardRuns<T>::load(run);  // Cache the first head
+                result.shards.push_back(run);
+            }
+            return result;
+        }
+
+        /**
+         * @return (shard, index) of every element in global insertion order, cached per version
+         * @throws None
+         */
+        std::shared_ptr<const std::vector<std::pair<size_t, size_t>>> insertionOrder() const {
+            if (!insertionCache || insertionCacheVersion != version) {
+                auto order = std::make_shared<std::vector<std::pair<size_t, size_t>>>();
+                order->reserve(count);
+                for (LoserTree<ShardRuns<T>> merge(runs(false, true)); !merge.empty(); merge.pop()) {
+                    size_t s = merge.top();
+                    order->push_back(std::make_pair(s, merge.sources().head(s)));  // Next oldest element
+                }
+                insertionCache = order;
+                insertionCacheVersion = version;
+            }
+            return insertionCache;
+        }
+
+        /**
+         * @param os Output stream to write to
+         * @param container ShardedContainer to print
+         * @return Reference to the output stream
+         * @throws None
+         */
+        // Print all elements in insertion order
+        friend std::ostream& operator<<(std::ostream& os, const ShardedContainer<T>& container) {
+            os << "[";
+            bool first = true;
+            for (auto it = container.begin_order(); it != container.end_order(); ++it) {
+                if (!first) {
+                    os << ", ";
+                }
+                os << *it;
+                first = false;
+            }
+            os << "]";
+            return os;
+        }
+
+        /**
+         * @return Iterator to the beginning of ascending order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_ascending_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Ascending);
+        }
+
+        /**
+         * @return Iterator to the end of ascending order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_ascending_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Ascending, true);
+        }
+
+        /**
+         * @return Iterator to the beginning of descending order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_descending_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Descending);
+        }
+
+        /**
+         * @return Iterator to the end of descending order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_descending_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Descending, true);
+        }
+
+        /**
+         * @return Iterator to the beginning of side-cross order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_side_cross_order() const {
+            return ShardedOrderIterator<T>(*this, Order::SideCross);
+        }
+
+        /**
+         * @return Iterator to the end of side-cross order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_side_cross_order() const {
+            return ShardedOrderIterator<T>(*this, Order::SideCross, true);
+        }
+
+        /**
+         * @return Iterator to the beginning of reverse order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_reverse_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Reverse);
+        }
+
+        /**
+         * @return Iterator to the end of reverse order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_reverse_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Reverse, true);
+        }
+
+        /**
+         * @return Iterator to the beginning of insertion order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Insertion);
+        }
+
+        /**
+         * @return Iterator to the end of insertion order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_order() const {
+            return ShardedOrderIterator<T>(*this, Order::Insertion, true);
+        }
+
+        /**
+         * @return Iterator to the beginning of middle-out order
+         * @throws None
+         */
+        ShardedOrderIterator<T> begin_middle_out_order() const {
+            return ShardedOrderIterator<T>(*this, Order::MiddleOut);
+        }
+
+        /**
+         * @return Iterator to the end of middle-out order
+         * @throws None
+         */
+        ShardedOrderIterator<T> end_middle_out_order() const {
+            return ShardedOrderIterator<T>(*this, Order::MiddleOut, true);
+        }
+
+        /**
+         * @return View over ascending order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> ascending() const {  // Range over ascending order
+            return OrderView<ShardedOrderIterator<T>>(begin_ascending_order(), end_ascending_order());
+        }
+
+        /**
+         * @return View over descending order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> descending() const {  // Range over descending order
+            return OrderView<ShardedOrderIterator<T>>(begin_descending_order(), end_descending_order());
+        }
+
+        /**
+         * @return View over side-cross order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> side_cross() const {  // Range over side-cross order
+            return OrderView<ShardedOrderIterator<T>>(begin_side_cross_order(), end_side_cross_order());
+        }
+
+        /**
+         * @return View over reverse order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> reverse() const {  // Range over reverse order
+            return OrderView<ShardedOrderIterator<T>>(begin_reverse_order(), end_reverse_order());
+        }
+
+        /**
+         * @return View over insertion order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> order() const {  // Range over insertion order
+            return OrderView<ShardedOrderIterator<T>>(begin_order(), end_order());
+        }
+
+        /**
+         * @return View over middle-out order
+         * @throws None
+         */
+        OrderView<ShardedOrderIterator<T>> middle_out() const {  // Range over middle-out order
+            return OrderView<ShardedOrderIterator<T>>(begin_middle_out_order(), end_middle_out_order());
+        }
+    };
+
+} // Namespace ariel
+
+#endif //SHARDEDCONTAINER_HPP  // Header guard
@@ -0,0 +1,288 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef SHARDEDORDERITERATOR_HPP  // Header guard to prevent multiple inclusions of this file
+#define SHARDEDORDERITERATOR_HPP
+
+#include <vector>      // Include vector header for run cursors
+#include <memory>      // Include memory header for std::shared_ptr
+#include <utility>     // Include utility header for std::pair
+#include <cstddef>     // Include cstddef header for size_t
+#include <iterator>    // Include iterator header for std::forward_iterator_tag
+#include <stdexcept>   // Include stdexcept header for exceptions
+#include "IteratorChecks.hpp"  // Include header for the checked / unchecked iterator policy
+#include "MyContainer.hpp"  // Include header for Order and the middle-out mapping
+#include "LoserTree.hpp"    // Include header for the k-way merge
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    template<typename T>
+    class ShardedContainer;  // Forward declaration of ShardedContainer class template
+
+    /**
+     * @brief One cursor per shard for LoserTree: walks a shard's ascending or descending permutation
+     * (or its insertion order) forwards or backwards. Ties between shards are broken by global sequence number,
+     * so the merge reproduces exactly the order a single MyContainer would give.
+     */
+    template<typename T> // Template struct definition for ShardRuns
+    struct ShardRuns {
+        struct Run {
+            const std::vector<T>* data;          // Shard values
+            const std::vector<size_t>* order;    // Shard ascending or descending permutation, or nullptr for insertion order
+            const std::vector<size_t>* sequence; // Global append sequence number of each shard element
+            size_t position;                     // Current position in order
+            size_t left;                         // Positions not yet consumed
+            size_t headIndex;                    // Cached data index at position, so matches never re-resolve it
+            const T* headValue;                  // Cached &data[headIndex]
+        };
+
+        std::vector<Run> shards;  // One run per shard
+        bool byValue = true;      // Compare values first (sorted orders) or only sequence numbers
+        bool forward = true;      // Walk forwards and take the oldest of equal elements first, or backwards and newest first
+        bool largestFirst = false;  // Value direction when byValue
+
+        /**
+         * @return Number of runs
+         * @throws None
+         */
+        size_t count() const {
+            return shards.size();
+        }
+
+        /**
+         * @param r Run index
+         * @return True if the run has no elements left
+         * @throws None
+         */
+        bool exhausted(size_t r) const {
+            return shards[r].left == 0;
+        }
+
+        /**
+         * @param r Run index, not exhausted
+         * @return Index into the shard's data of the run's head
+         * @throws None
+         */
+        size_t head(size_t r) const {
+            return shards[r].headIndex;
+        }
+
+        /**
+         * @param run Run whose position changed
+         * @return None
+         * @throws None
+         */
+        static void load(Run& run) {  // Refresh the cached head after a move
+            if (run.left == 0) {
+                return;  // Nothing to read
+            }
+            run.headIndex = run.order ? (*run.order)[run.position] : run.position;
+            run.headValue = &(*run.data)[run.headIndex];  // Sequence numbers are read only on ties
+        }
+
+        /**
+         * @param a Run index, not exhausted
+         * @param b Run index, not exhausted
+         * @return True if a's head comes before b's head
+         * @throws None
+         */
+        bool before(size_t a, size_t b) const {
+            const Run& ra = shards[a];
+            const Run& rb = shards[b];
+            if (byValue) {
+                const T& va = *ra.headValue;
+                const T& vb = *rb.headValue;
+                if (va < vb) {
+                    return !largestFirst;  // Smaller first when ascending
+                }
+                if (vb < va) {
+                    return largestFirst;  // Larger first when descending
+                }
+            }
+            size_t sa = (*ra.sequence)[ra.headIndex];  // Equal values: global insertion order decides
+            size_t sb = (*rb.sequence)[rb.headIndex];
+            return forward ? sa < sb : sa > sb;
+        }
+
+        /**
+         * @param r Run index, not exhausted
+         * @return None
+         * @throws None
+         */
+        void advance(size_t r) {
+            Run& run = shards[r];
+            --run.left;
+            if (forward) {
+                ++run.position;
+            } else {
+                --run.position;  // Wraps only once the run is exhausted, when it is never read again
+            }
+            load(run);
+        }
+    };
+
+    template<typename T> // Template class definition for ShardedOrderIterator
+    class ShardedOrderIterator {
+    private:
+        typedef LoserTree<ShardRuns<T>> Merge;  // k-way merge over the shards
+
+        const ShardedContainer<T>* container;  // Pointer to the ShardedContainer instance
+        Order order;                           // Which of the six orders
+        size_t index;                          // Current position in that order
+        size_t capturedVersion;                // Version of the container at iterator creation
+        Merge front;                           // Ascending / descending / insertion / reverse merge (side-cross: small end); O(shards) to copy
+        Merge back;                            // Side-cross only: large end
+        std::shared_ptr<const std::vector<std::pair<size_t, size_t>>> global;  // Middle-out only: (shard, index) in insertion order
+
+        /**
+         * @param tree Merge to read
+         * @return (shard, index) of the merge's current head
+         * @throws None
+         */
+        static std::pair<size_t, size_t> headOf(const Merge& tree) {
+            size_t shard = tree.top();
+            return std::make_pair(shard, tree.sources().head(shard));
+        }
+
+        /**
+         * @return (shard, index) of the current element
+         * @throws None
+         */
+        std::pair<size_t, size_t> current() const {
+            if (order == Order::MiddleOut) {
+                return (*global)[MiddleOutOrder::map(index, global->size())];  // Same mapping as MyContainer
+            }
+            if (order == Order::SideCross && index % 2 == 1) {
+                return headOf(back);  // Odd positions come from the large end
+            }
+            return headOf(front);
+        }
+
+        /**
+         * @param endMessage Message for the out-of-range exception
+         * @return None
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        void check(const char* endMessage) const ARIEL_ITERATOR_NOEXCEPT {  // Shared validity checks
+            ARIEL_ITERATOR_CHECK(capturedVersion != container->getVersion(), std::runtime_error, "Container modified during iteration");  // Ensure container was not modified since iterator creation
+            ARIEL_ITERATOR_CHECK(index >= container->size(), std::out_of_range, endMessage);  // Check if index is out of bounds
+        }
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;  // A merge can only step forwards
+        typedef T value_type;                                  // Element type
+        typedef std::ptrdiff_t difference_type;                // Signed distance between positions
+        typedef const T* pointer;                              // Result of operator->
+        typedef const T& reference;                            // Result of operator*
+
+        /**
+         * @throws None
+         */
+        ShardedOrderIterator() : container(nullptr), order(Order::Insertion), index(0), capturedVersion(0) {}  // Singular iterator; may only be assigned to
+
+        /**
+         * @param cont Reference to the ShardedContainer to iterate over
+         * @param ord Order to traverse
+         * @param is_end If true, initializes iterator to end position; default is false
+         * @throws None
+         */
+        ShardedOrderIterator(const ShardedContainer<T>& cont, Order ord, bool is_end = false)  // Constructor for iterator
+            : container(&cont), order(ord), index(0), capturedVersion(cont.getVersion()) {  // Merges stay empty until needed
+            if (is_end) {  // End iterator only needs the size, so skip building the merge
+                index = container->size();  // Past-the-end position
+                return;
+            }
+            switch (order) {
+                case Order::Ascending:
+                case Order::SideCross:
+                    front = Merge(container->runs(true, true));  // Smallest first
+                    break;
+                case Order::Descending:
+                    front = Merge(container->runs(true, false, true));  // Largest first, equal values oldest first
+                    break;
+                case Order::Insertion:
+                    front = Merge(container->runs(false, true));  // Oldest first
+                    break;
+                case Order::Reverse:
+                    front = Merge(container->runs(false, false));  // Newest first
+                    break;
+                case Order::MiddleOut:
+                    global = container->insertionOrder();  // Needs random access by position
+                    break;
+            }
+            if (order == Order::SideCross) {
+                back = Merge(container->runs(true, false));  // Largest first
+            }
+        }
+
+        /**
+         * @return Reference to the current element, valid until the container is modified
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        const T& operator*() const ARIEL_ITERATOR_NOEXCEPT {  // Return current element
+            check("Iterator out of range");
+            std::pair<size_t, size_t> at = current();
+            return container->getShard(at.first).getData()[at.second];
+        }
+
+        /**
+         * @return Pointer to the current element, valid until the container is modified
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        const T* operator->() const ARIEL_ITERATOR_NOEXCEPT {  // Member access on the current element
+            return std::addressof(**this);  // Same checks as operator*
+        }
+
+        /**
+         * @return Reference to incremented iterator
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        ShardedOrderIterator& operator++() ARIEL_ITERATOR_NOEXCEPT {  // Increment iterator (prefix)
+            check("Cannot increment beyond end.");
+            if (order == Order::SideCross && index % 2 == 1) {
+                back.pop();  // Consume from the large end
+            } else if (order != Order::MiddleOut) {
+                front.pop();  // Consume from the merge: O(log shards)
+            }
+            ++index;
+            return *this;
+        }
+
+        /**
+         * @return Copy of iterator before increment
+         * @throws std::runtime_error If container was modified during iteration
+         * @throws std::out_of_range If iterator is at or beyond end
+         */
+        ShardedOrderIterator operator++(int) ARIEL_ITERATOR_NOEXCEPT {  // Increment iterator (postfix)
+            ShardedOrderIterator temp = *this;  // Save current iterator state
+            ++(*this);
+            return temp;
+        }
+
+        /**
+         * @brief Equality comparison operator.
+         * @param other Another iterator to compare.
+         * @return True if both iterators are at the same position and container.
+         */
+        bool operator==(const ShardedOrderIterator& other) const {
+            return index == other.index && container == other.container;
+        }
+
+        /**
+         * @brief Inequality comparison operator.
+         * @param other Another iterator to compare.
+         * @return True if iterators are at different positions or containers.
+         */
+        bool operator!=(const ShardedOrderIterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+} // Namespace ariel
+
+#endif //SHARDEDORDERITERATOR_HPP  // Header guard
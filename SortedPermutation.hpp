@@ -0,0 +1,314 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef SORTEDPERMUTATION_HPP  // Header guard to prevent multiple inclusions of this file
+#define SORTEDPERMUTATION_HPP
+
+#include <vector>      // Include vector header for index storage
+#include <algorithm>   // Include algorithm header for std::sort and std::nth_element
+#include <cstddef>     // Include cstddef header for size_t and std::ptrdiff_t
+#include <deque>       // Include deque header for the partition boundaries of the lazy middle
+#include <atomic>      // Include atomic header for publishing finalized ranks
+#include <mutex>       // Include mutex header for serializing refinement
+#include "IndexSort.hpp"  // Include header for IndexLess and sortIndices
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief How a container builds its ascending permutation.
+     * Eager sorts everything up front; Lazy sorts only the ranks that are actually read.
+     */
+    enum class SortMode {
+        Eager,  // Full sort when the permutation is built
+        Lazy    // Sort growing chunks from either end on demand
+    };
+
+    template<typename T> // Template class definition for SortedPermutation
+    class SortedPermutation {
+    private:
+        static const size_t MIN_CHUNK = 64;  // Smallest number of ranks finalized per lazy step
+        static const size_t SPLIT_FRACTION = 8;  // A split keeps 1/8 of a segment on the outer side
+
+        // Ranks in [0, sortedFront) and [sortedBack, n) hold their final index; the middle is unsorted.
+        // Refinement only reorders the unsorted middle, so the order it represents never changes.
+        //
+        // One permutation is shared by container copies, snapshot iterators and iterators on other threads,
+        // so lazy refinement runs under refineMutex. It publishes each finalized segment with a release store
+        // of sortedFront / sortedBack; a reader that sees its rank outside the middle (acquire load) reads
+        // indices[rank] without locking, since refinement never writes finalized ranks again.
+        mutable std::vector<size_t> indices;  // Permutation of 0..n-1
+        mutable std::atomic<size_t> sortedFront;  // Number of finalized ranks at the front
+        mutable std::atomic<size_t> sortedBack;   // First finalized rank at the back
+        mutable std::deque<size_t> splits;    // Ascending ranks inside the middle; each splits it into smaller and larger values; guarded by refineMutex
+        mutable std::vector<size_t> descending;  // Largest first, equal values by insertion order; built once complete
+        mutable std::atomic<bool> descendingReady;  // Published after descending is built
+        mutable std::mutex refineMutex;       // Serializes refinement and the one-time descending build
+
+        /**
+         * @param rank Rank inside the unsorted middle
+         * @param data Values the permutation orders
+         * @return None
+         * @throws None
+         */
+        // Caller holds refineMutex.
+        // Incremental quickselect from whichever end is closer to rank: the outermost segment of the middle
+        // is split with nth_element, keeping 1/SPLIT_FRACTION of it on the outer side, until it is at most
+        // twice the ranks still needed (and MIN_CHUNK), then sorted. Each split touches only the segment the
+        // previous one left and the split points are kept, so the first k ranks from either end cost
+        // O(n + k log k) in total; the first read scans about n * 8/7 indices.
+        void refine(size_t rank, const std::vector<T>& data) const {
+            IndexLess<T> less{data};  // Comparator over container values
+            bool fromFront = rank - sortedFront <= sortedBack - 1 - rank;  // Grow the nearer end
+            auto at = [this](size_t r) { return indices.begin() + static_cast<std::ptrdiff_t>(r); };
+            while (rank >= sortedFront && rank < sortedBack) {
+                if (fromFront) {
+                    size_t first = sortedFront;  // Leftmost segment: smallest unsorted values
+                    size_t last = splits.empty() ? sortedBack.load() : splits.front();
+                    while (last - first > 2 * std::max(rank + 1 - first, MIN_CHUNK)) {
+                        size_t mid = first + std::max<size_t>((last - first) / SPLIT_FRACTION, 1);
+                        std::nth_element(at(first), at(mid), at(last), less);  // Split off the smallest values
+                        splits.push_front(mid);
+                        last = mid;
+                    }
+                    std::sort(at(first), at(last), less);  // Order the segment
+                    sortedFront = last;  // Extend finalized front
+                    if (!splits.empty() && splits.front() == last) {
+                        splits.pop_front();  // Boundary is now the finalized edge
+                    }
+                } else {
+                    size_t last = sortedBack;  // Rightmost segment: largest unsorted values
+                    size_t first = splits.empty() ? sortedFront.load() : splits.back();
+                    while (last - first > 2 * std::max(last - rank, MIN_CHUNK)) {
+                        size_t mid = last - std::max<size_t>((last - first) / SPLIT_FRACTION, 1);
+                        std::nth_element(at(first), at(mid), at(last), less);  // Split off the largest values
+                        splits.push_back(mid);
+                        first = mid;
+                    }
+                    std::sort(at(first), at(last), less);  // Order the segment
+                    sortedBack = first;  // Extend finalized back
+                    if (!splits.empty() && splits.back() == first) {
+                        splits.pop_back();  // Boundary is now the finalized edge
+                    }
+                }
+            }
+        }
+
+        /**
+         * @param rank Any rank, must be less than size()
+         * @param data Values the permutation orders
+         * @param up True for the last rank of the run, false for the first
+         * @return Last (or first) rank holding a value equal to the one at rank
+         * @throws None
+         */
+        // Gallops away from rank, then binary searches; only the probed ranks are finalized
+        size_t runEdge(size_t rank, const std::vector<T>& data, bool up) const {
+            IndexLess<T> less{data};  // Comparator over container values
+            size_t value = indexAtRank(rank, data);  // Index of the value whose run we want
+            size_t limit = up ? indices.size() - 1 - rank : rank;  // Farthest distance that stays in range
+            auto same = [&](size_t distance) {
+                return less.equivalent(value, indexAtRank(up ? rank + distance : rank - distance, data));
+            };
+            size_t inside = 0;  // Distance known to be in the run
+            size_t step = 1;    // Next gallop step
+            while (inside + step <= limit && same(inside + step)) {
+                inside += step;
+                step *= 2;  // Gallop
+            }
+            size_t outside = std::min(inside + step, limit + 1);  // Distance known to be past the run
+            while (outside - inside > 1) {
+                size_t mid = inside + (outside - inside) / 2;
+                if (same(mid)) {
+                    inside = mid;
+                } else {
+                    outside = mid;
+                }
+            }
+            return up ? rank + inside : rank - inside;
+        }
+
+    public:
+        static const size_t REMOVED = static_cast<size_t>(-1);  // Marks a removed element in a remap table
+
+        /**
+         * @param data Values to order
+         * @param mode Eager sorts now; Lazy defers sorting until ranks are read
+         * @throws None
+         */
+        SortedPermutation(const std::vector<T>& data, SortMode mode)  // Build permutation of data
+            : indices(data.size()), sortedFront(0), sortedBack(data.size()), descendingReady(false) {
+            for (size_t i = 0; i < indices.size(); ++i) {
+                indices[i] = i;  // Initialize with 0, 1, 2, ...
+            }
+            if (mode == SortMode::Eager) {  // Sort everything up front
+                sortIndices<T>(indices.begin(), indices.end(), data);  // Full sort with the best backend for T
+                sortedFront = sortedBack.load();  // Everything is final
+            }
+        }
+
+        /**
+         * @param sorted Indices already in final ascending order
+         * @throws None
+         */
+        explicit SortedPermutation(std::vector<size_t>&& sorted)  // Adopt a fully sorted permutation
+            : indices(std::move(sorted)), sortedFront(0), sortedBack(0), descendingReady(false) {}
+
+        /**
+         * @param sorted Indices already in final ascending order
+         * @param reversed The same indices largest first, equal elements by insertion order
+         * @throws None
+         */
+        // For orders whose ties are not defined by T's operator<, e.g. a comparator on a projection
+        SortedPermutation(std::vector<size_t>&& sorted, std::vector<size_t>&& reversed)  // Adopt both directions
+            : indices(std::move(sorted)), sortedFront(0), sortedBack(0), descending(std::move(reversed)), descendingReady(true) {}
+
+        /**
+         * @param previous Permutation built before some elements were removed
+         * @param newPosition Maps every old data index to its new index, or REMOVED
+         * @throws None
+         */
+        // Drops removed indices and renumbers survivors in one linear pass; sorted regions stay sorted
+        SortedPermutation(const SortedPermutation& previous, const std::vector<size_t>& newPosition)  // Patch after removal
+            : sortedFront(0), sortedBack(0), descendingReady(false) {
+            std::lock_guard<std::mutex> lock(previous.refineMutex);  // A copy or snapshot may be refining it
+            indices.reserve(previous.indices.size());  // At most as many survivors as before
+            for (size_t rank = 0; rank < previous.indices.size(); ++rank) {
+                if (rank == previous.sortedBack) {
+                    sortedBack = indices.size();  // Back region starts at the first survivor at or after the old boundary
+                }
+                size_t moved = newPosition[previous.indices[rank]];  // New index of this element
+                if (moved != REMOVED) {
+                    indices.push_back(moved);  // Keep survivor with its new index
+                }
+                if (rank + 1 == previous.sortedFront) {
+                    sortedFront = indices.size();  // Survivors in the old front region stay final
+                }
+            }
+            if (previous.sortedBack >= previous.indices.size()) {
+                sortedBack = indices.size();  // No finalized back region
+            }
+            if (previous.isComplete()) {
+                sortedFront = sortedBack = indices.size();  // Complete stays complete
+            }
+        }
+
+        /**
+         * @param data Values the permutation orders; data[size(), data.size()) were appended since it was built
+         * @return New complete permutation covering all of data
+         * @throws None
+         */
+        // Sorts only the appended tail (k log k) and merges it with the existing order (n + k)
+        std::vector<size_t> mergeAppended(const std::vector<T>& data) const {  // Extend permutation with appended elements
+            IndexLess<T> less{data};  // Comparator over container values
+            const std::vector<size_t>& head = sortedIndices(data);  // Existing ranks, completed if lazy
+            std::vector<size_t> tail(data.size() - head.size());  // Indices of appended elements
+            for (size_t i = 0; i < tail.size(); ++i) {
+                tail[i] = head.size() + i;  // Appended indices follow all existing ones
+            }
+            sortIndices<T>(tail.begin(), tail.end(), data);  // Sort only the new elements
+
+            std::vector<size_t> merged(data.size());  // Output permutation
+            std::merge(head.begin(), head.end(), tail.begin(), tail.end(), merged.begin(), less);  // Linear merge
+            return merged;  // Return combined permutation
+        }
+
+        /**
+         * @return Number of indices in the permutation
+         * @throws None
+         */
+        size_t size() const {  // Return permutation size
+            return indices.size();
+        }
+
+        /**
+         * @return True if every rank is final
+         * @throws None
+         */
+        bool isComplete() const {  // Check whether the middle is empty
+            return sortedFront.load(std::memory_order_acquire) >= sortedBack.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @param rank Position in ascending order, must be less than size()
+         * @param data Values the permutation was built from
+         * @return Index into data of the element with that rank
+         * @throws None
+         */
+        size_t indexAtRank(size_t rank, const std::vector<T>& data) const {  // Look up (and lazily sort) one rank
+            if (rank >= sortedFront.load(std::memory_order_acquire) && rank < sortedBack.load(std::memory_order_acquire)) {  // Rank still in the unsorted middle
+                std::lock_guard<std::mutex> lock(refineMutex);
+                refine(rank, data);  // Finalize a chunk containing it, unless another thread just did
+            }
+            return indices[rank];  // Final index for this rank
+        }
+
+        /**
+         * @param position Position in descending order, must be less than size()
+         * @param data Values the permutation was built from
+         * @return Index into data of the element at that position; equal elements by insertion order
+         * @throws None
+         */
+        // A lazy permutation maps the position to its ascending rank and flips it inside its run of equal
+        // values, so only ranks near the top are finalized; a complete one reads descendingIndices()
+        size_t indexAtDescendingRank(size_t position, const std::vector<T>& data) const {  // Look up one descending position
+            if (isComplete()) {
+                return descendingIndices(data)[position];  // O(1) once built
+            }
+            size_t rank = indices.size() - 1 - position;  // Same position read from the top
+            return indexAtRank(runEdge(rank, data, false) + runEdge(rank, data, true) - rank, data);  // Mirror inside the run
+        }
+
+        /**
+         * @param data Values the permutation was built from
+         * @return Indices into data from largest to smallest, equal elements by insertion order
+         * @throws None
+         */
+        const std::vector<size_t>& descendingIndices(const std::vector<T>& data) const {  // Complete and expose descending order
+            if (!descendingReady.load(std::memory_order_acquire)) {  // Not built yet
+                const std::vector<size_t>& ascending = sortedIndices(data);
+                std::lock_guard<std::mutex> lock(refineMutex);
+                if (!descendingReady.load(std::memory_order_relaxed)) {  // Another thread may have built it meanwhile
+                    IndexLess<T> less{data};  // Same equality the ascending order used
+                    descending = reverseKeepingTies(ascending, [&](size_t r, size_t next) {
+                        return less.equivalent(ascending[r], ascending[next]);
+                    });
+                    descendingReady.store(true, std::memory_order_release);
+                }
+            }
+            return descending;
+        }
+
+        /**
+         * @param data Values the permutation was built from
+         * @return Fully sorted indices into data
+         * @throws None
+         */
+        const std::vector<size_t>& sortedIndices(const std::vector<T>& data) const {  // Complete and expose all ranks
+            if (!isComplete()) {
+                std::lock_guard<std::mutex> lock(refineMutex);
+                IndexLess<T> less{data};  // Comparator over container values
+                size_t first = sortedFront;
+                for (size_t split : splits) {
+                    std::sort(indices.begin() + first, indices.begin() + split, less);  // Segments are already in order
+                    first = split;
+                }
+                std::sort(indices.begin() + first, indices.begin() + sortedBack, less);  // Last segment
+                splits.clear();
+                sortedFront.store(sortedBack.load(), std::memory_order_release);  // Everything is final
+            }
+            return indices;  // Return the full permutation
+        }
+    };
+
+    template<typename T>
+    const size_t SortedPermutation<T>::MIN_CHUNK;  // Out-of-class definition for the ODR-used constant
+
+    template<typename T>
+    const size_t SortedPermutation<T>::SPLIT_FRACTION;  // Out-of-class definition for the constant
+
+    template<typename T>
+    const size_t SortedPermutation<T>::REMOVED;  // Out-of-class definition for the ODR-used constant
+
+} // Namespace ariel
+
+#endif //SORTEDPERMUTATION_HPP  // Header guard
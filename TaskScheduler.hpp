@@ -0,0 +1,327 @@
+/*
+Mail - ariel.yaacobi@msmail.ariel.ac.il
+*/
+
+#ifndef TASKSCHEDULER_HPP  // Header guard to prevent multiple inclusions of this file
+#define TASKSCHEDULER_HPP
+
+#include <vector>              // Include vector header for worker storage
+#include <deque>               // Include deque header for per-worker task queues
+#include <thread>              // Include thread header for std::thread
+#include <mutex>               // Include mutex header for queue synchronization
+#include <condition_variable>  // Include condition_variable header for idle workers
+#include <functional>          // Include functional header for std::function
+#include <atomic>              // Include atomic header for task counters
+#include <memory>              // Include memory header for std::unique_ptr
+#include <exception>           // Include exception header for std::exception_ptr
+#include <algorithm>           // Include algorithm header for std::min
+#include <cstddef>             // Include cstddef header for size_t
+
+namespace ariel { // Namespace to encapsulate classes and functions
+
+    /**
+     * @brief Work-stealing scheduler shared by all parallel container operations.
+     *
+     * Each worker owns a deque: it pushes and pops its own tasks at the back (LIFO, cache-warm)
+     * while idle workers steal from the front of other deques (FIFO, oldest and largest tasks).
+     * Tasks submitted from outside the pool are spread round-robin over the deques.
+     * Threads waiting on a TaskGroup run queued tasks while there are any and sleep like an idle
+     * worker otherwise, so nested fork/join never deadlocks and waiters never spin on a busy machine.
+     */
+    class TaskScheduler {
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;                          // Guards tasks
+            std::deque<std::function<void()>> tasks;   // Owner works at the back, thieves at the front
+        };
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;  // One deque per worker
+        std::vector<std::thread> workers;                  // Worker threads
+        std::atomic<size_t> queued{0};                     // Tasks pushed but not yet taken
+        std::atomic<size_t> nextQueue{0};                  // Round-robin target for external submissions
+        std::mutex sleepMutex;                             // Guards stopping and idle waits
+        std::condition_variable sleepCv;                   // Wakes idle workers
+        bool stopping = false;                             // Set when the scheduler is being destroyed
+
+        /**
+         * @return Scheduler owning the calling thread, or nullptr for non-worker threads
+         * @throws None
+         */
+        static TaskScheduler*& currentScheduler() {  // Thread-local owner
+            static thread_local TaskScheduler* scheduler = nullptr;
+            return scheduler;
+        }
+
+        /**
+         * @return Index of the calling worker within its scheduler
+         * @throws None
+         */
+        static size_t& currentIndex() {  // Thread-local worker index
+            static thread_local size_t index = 0;
+            return index;
+        }
+
+        /**
+         * @param home Deque to try first
+         * @param own True if home belongs to the calling worker (pop from the back)
+         * @param task Receives the task taken
+         * @return True if a task was taken
+         * @throws None
+         */
+        bool take(size_t home, bool own, std::function<void()>& task) {  // Pop own work, else steal
+            if (own) {
+                WorkerQueue& q = *queues[home];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (!q.tasks.empty()) {
+                    task = std::move(q.tasks.back());  // Newest own task
+                    q.tasks.pop_back();
+                    return true;
+                }
+            }
+            for (size_t k = own ? 1 : 0; k < queues.size(); ++k) {  // Visit every other deque once
+                WorkerQueue& victim = *queues[(home + k) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());  // Oldest task of the victim
+                    victim.tasks.pop_front();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @param index Worker index
+         * @return None
+         * @throws None
+         */
+        void workerLoop(size_t index) {  // Run and steal tasks until shutdown
+            currentScheduler() = this;
+            currentIndex() = index;
+            while (true) {
+                if (runPendingTask()) {
+                    continue;  // Keep going while there is work
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                sleepCv.wait(lock, [this] { return stopping || queued.load() > 0; });  // Idle until work or shutdown
+                if (stopping && queued.load() == 0) {
+                    return;  // Queues drained
+                }
+            }
+        }
+
+    public:
+        /**
+         * @param threads Number of worker threads; at least one is started
+         * @throws std::system_error If a thread cannot be started
+         */
+        explicit TaskScheduler(size_t threads) {  // Start workers
+            if (threads == 0) {
+                threads = 1;  // Always have a worker
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                queues.emplace_back(new WorkerQueue());  // One deque per worker
+            }
+            for (size_t i = 0; i < threads; ++i) {
+                workers.emplace_back([this, i] { workerLoop(i); });  // Start worker
+            }
+        }
+
+        TaskScheduler(const TaskScheduler&) = delete;             // Schedulers are not copyable
+        TaskScheduler& operator=(const TaskScheduler&) = delete;  // Schedulers are not assignable
+
+        /**
+         * @throws None
+         */
+        ~TaskScheduler() {  // Finish queued tasks and join workers
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;  // Ask workers to exit once queues are empty
+            }
+            sleepCv.notify_all();
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+        }
+
+        /**
+         * @param task Work to run on some worker
+         * @return None
+         * @throws None
+         */
+        void submit(std::function<void()> task) {  // Queue a task
+            size_t target = currentScheduler() == this
+                ? currentIndex()                                 // Workers push onto their own deque
+                : nextQueue.fetch_add(1) % queues.size();        // Outside threads spread the load
+            {
+                std::lock_guard<std::mutex> lock(queues[target]->mutex);
+                queues[target]->tasks.push_back(std::move(task));
+            }
+            queued.fetch_add(1);
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);  // Pairs with the idle wait so the wake-up is not lost
+            }
+            sleepCv.notify_one();
+        }
+
+        /**
+         * @return True if a queued task was run on the calling thread
+         * @throws None
+         */
+        // Lets a waiting thread (worker or not) make progress instead of blocking
+        bool runPendingTask() {
+            bool own = currentScheduler() == this;  // Workers prefer their own deque
+            size_t home = own ? currentIndex() : nextQueue.load() % queues.size();
+            std::function<void()> task;
+            if (!take(home, own, task)) {
+                return false;
+            }
+            queued.fetch_sub(1);
+            task();  // TaskGroup wraps tasks so they never throw here
+            return true;
+        }
+
+        /**
+         * @param done Predicate that turns true once the caller may stop waiting
+         * @return None
+         * @throws None
+         */
+        // Whoever makes done() true must call wake() afterwards; submit() wakes sleepers too, so a
+        // waiter still helps with tasks forked while it sleeps
+        template<typename Done>
+        void helpUntil(Done done) {  // Run queued tasks, sleep when there are none
+            while (!done()) {
+                if (runPendingTask()) {
+                    continue;  // Keep going while there is work
+                }
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                sleepCv.wait(lock, [this, &done] { return done() || queued.load() > 0; });  // Remaining work runs elsewhere
+            }
+        }
+
+        /**
+         * @return None
+         * @throws None
+         */
+        void wake() {  // Re-check every sleeping worker and waiter
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);  // Pairs with the waits so the wake-up is not lost
+            }
+            sleepCv.notify_all();
+        }
+
+        /**
+         * @return Number of worker threads
+         * @throws None
+         */
+        size_t size() const {
+            return workers.size();
+        }
+
+        /**
+         * @return Process-wide scheduler with one worker per hardware thread
+         * @throws None
+         */
+        static TaskScheduler& global() {  // Default scheduler for parallel operations
+            static TaskScheduler scheduler(std::thread::hardware_concurrency());  // Created on first use
+            return scheduler;
+        }
+    };
+
+    /**
+     * @brief Fork/join scope: run() forks tasks onto a scheduler, wait() joins them.
+     * The first exception thrown by a task is rethrown from wait().
+     */
+    class TaskGroup {
+    private:
+        TaskScheduler& scheduler;          // Where tasks run
+        std::atomic<size_t> pending{0};    // Forked tasks not yet finished
+        std::mutex errorMutex;             // Guards error
+        std::exception_ptr error;          // First failure
+
+    public:
+        /**
+         * @param sched Scheduler to run tasks on; defaults to the global one
+         * @throws None
+         */
+        explicit TaskGroup(TaskScheduler& sched = TaskScheduler::global()) : scheduler(sched) {}
+
+        TaskGroup(const TaskGroup&) = delete;             // Groups are not copyable
+        TaskGroup& operator=(const TaskGroup&) = delete;  // Groups are not assignable
+
+        /**
+         * @throws None
+         */
+        ~TaskGroup() {  // Tasks refer to this group, so never leave before they finish
+            scheduler.helpUntil([this] { return pending.load() == 0; });
+        }
+
+        /**
+         * @param fn Callable with no arguments
+         * @return None
+         * @throws None
+         */
+        template<typename F>
+        void run(F fn) {  // Fork
+            pending.fetch_add(1);
+            TaskScheduler& sched = scheduler;  // Captured directly: the group may be gone once pending hits zero
+            scheduler.submit([this, &sched, fn]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();  // Keep the first failure
+                    }
+                }
+                if (pending.fetch_sub(1) == 1) {  // Last access to the group
+                    sched.wake();  // The waiter may be asleep
+                }
+            });
+        }
+
+        /**
+         * @return None
+         * @throws Any exception thrown by a forked task
+         */
+        void wait() {  // Join, helping with queued work meanwhile
+            scheduler.helpUntil([this] { return pending.load() == 0; });
+            if (error) {
+                std::exception_ptr failure = error;
+                error = nullptr;
+                std::rethrow_exception(failure);
+            }
+        }
+    };
+
+    /**
+     * @param begin First index of the range
+     * @param end One past the last index
+     * @param chunks Number of pieces to split the range into
+     * @param body Callable invoked as body(lo, hi) for each piece
+     * @param scheduler Scheduler to run on
+     * @return None
+     * @throws Any exception thrown by body
+     */
+    // Fork/join helper: splits [begin, end) into even pieces and runs them concurrently
+    template<typename F>
+    void parallelFor(size_t begin, size_t end, size_t chunks, F body,
+                     TaskScheduler& scheduler = TaskScheduler::global()) {
+        size_t n = end > begin ? end - begin : 0;  // Range length
+        chunks = std::max<size_t>(1, std::min(chunks, n));  // No empty pieces
+        if (chunks == 1) {
+            body(begin, end);  // Not worth forking
+            return;
+        }
+        TaskGroup group(scheduler);
+        for (size_t i = 0; i < chunks; ++i) {
+            size_t lo = begin + n * i / chunks;  // Piece start
+            size_t hi = begin + n * (i + 1) / chunks;  // Piece end
+            group.run([&body, lo, hi] { body(lo, hi); });
+        }
+        group.wait();
+    }
+
+} // Namespace ariel
+
+#endif //TASKSCHEDULER_HPP  // Header guard
@@ -5,9 +5,15 @@ Mail - ariel.yaacobi@msmail.ariel.ac.il
 
 #include "doctest.h"  // Includes the doctest testing framework
 #include "MyContainer.hpp"  // Includes the MyContainer class header
+#include "ConcurrentMyContainer.hpp"  // Includes the thread-safe container
+#include "ShardedContainer.hpp"  // Includes the sharded container
 #include <vector>  // Includes vector container from STL
 #include <string>  // Includes string class from STL
 #include <sstream>  // Includes string stream for output capture
+#include <limits>  // Includes numeric limits for extreme values
+#include <cmath>  // Includes cmath for std::isnan
+#include <atomic>  // Includes atomic counters for parallel traversal
+#include <thread>  // Includes std::thread for concurrency tests
 
 using namespace ariel;  // Uses the ariel namespace
 using namespace std;  // Uses the standard namespace
@@ -1707,4 +1713,1265 @@ TEST_CASE("Iterators with float") {  // Tests iterators with floats
                       insertion_order,    // Expected insertion order
                       expected_mid);          // Expected middle out order
     }
-}
\ No newline at end of file
+}
+// Tests the container's cached ascending permutation
+// This test case verifies that the sorted permutation shared by the ascending,
+// descending and side-cross iterators is reused while the container is unchanged
+// and rebuilt after every modification.
+TEST_CASE("Sorted permutation cache follows container version") {  // Tests sorted cache reuse and invalidation
+    MyContainer<int> c;  // Creates integer container
+    c.addElement(5);  // Adds element 5
+    c.addElement(1);  // Adds element 1
+    c.addElement(3);  // Adds element 3
+
+    auto first = c.getSortedPermutation();  // Builds the cache
+    CHECK(first->sortedIndices(c.getData()) == vector<size_t>{1, 2, 0});  // Verifies ascending permutation
+    CHECK(c.getSortedPermutation() == first);  // Verifies the same shared buffer is returned
+
+    auto stale = c.begin_ascending_order();  // Iterator created before modification
+    c.addElement(2);  // Modifies container
+    CHECK(c.getSortedIndices() == vector<size_t>{1, 3, 2, 0});  // Verifies cache was rebuilt
+    CHECK(c.getSortedPermutation() != first);  // Verifies a fresh buffer replaced the old one
+    CHECK(first->size() == 3);  // Verifies the old buffer is untouched by the rebuild
+    CHECK_THROWS_AS(*stale, runtime_error);  // Verifies stale iterator detects modification
+
+    vector<int> asc, desc, side;  // Stores traversal results
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) asc.push_back(*it);  // Ascending
+    for (auto it = c.begin_descending_order(); it != c.end_descending_order(); ++it) desc.push_back(*it);  // Descending
+    for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) side.push_back(*it);  // Side cross
+    CHECK(asc == vector<int>{1, 2, 3, 5});  // Verifies ascending order
+    CHECK(desc == vector<int>{5, 3, 2, 1});  // Verifies descending order
+    CHECK(side == vector<int>{1, 5, 2, 3});  // Verifies side cross order
+
+    c.removeElement(3);  // Modifies container again
+    CHECK(c.getSortedIndices() == vector<size_t>{1, 2, 0});  // Verifies cache matches remaining data {5, 1, 2}
+}
+
+// Tests that iterator copies share their index buffer
+// This test case verifies that copying an iterator (assignment, postfix
+// increment) keeps both copies independent in position while the underlying
+// permutation is shared rather than duplicated.
+TEST_CASE("Iterator copies share index storage") {  // Tests shared index buffers
+    MyContainer<int> c;  // Creates integer container
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);  // Adds elements
+    }
+    auto cache = c.getSortedPermutation();  // Holds the shared permutation
+    long before = cache.use_count();  // References before creating iterators
+
+    auto asc = c.begin_ascending_order();  // Shares the permutation
+    auto copy = asc;  // Copy shares it too
+    CHECK(cache.use_count() == before + 2);  // Verifies no new buffer was allocated
+    auto old = copy++;  // Postfix increment copies the iterator
+    CHECK(*old == 1);  // Verifies the returned copy kept its position
+    CHECK(*copy == 2);  // Verifies the incremented copy advanced
+    CHECK(*asc == 1);  // Verifies the original is unaffected
+
+    auto mid = c.begin_middle_out_order();  // Middle out iterator
+    auto midCopy = mid;  // Copy of middle out iterator
+    ++midCopy;  // Advances only the copy
+    CHECK(*mid == 6);  // Verifies original position
+    CHECK(*midCopy == 15);  // Verifies copy position
+
+    auto side = c.begin_side_cross_order();  // Side cross iterator
+    auto sideCopy = side;  // Copy of side cross iterator
+    ++sideCopy;  // Advances only the copy
+    CHECK(*side == 1);  // Verifies original position
+    CHECK(*sideCopy == 15);  // Verifies copy position
+}
+
+// Tests the closed-form middle-out mapping
+// This test case compares the middle-out iterator against an explicit
+// center-outward walk for every size from 0 to 40, covering odd and even sizes.
+TEST_CASE("Middle out order matches center-outward walk for all sizes") {  // Tests middle out position mapping
+    for (int n = 0; n <= 40; ++n) {  // Loops over container sizes
+        MyContainer<int> c;  // Creates integer container
+        for (int i = 0; i < n; ++i) {
+            c.addElement(i);  // Value equals data index
+        }
+
+        vector<int> expected;  // Expected data indices
+        if (n > 0) {
+            int mid = n / 2;  // Middle index
+            expected.push_back(mid);  // Middle first
+            for (int left = mid - 1, right = mid + 1; left >= 0 || right < n;) {  // Expand outward
+                if (left >= 0) expected.push_back(left--);  // Left side
+                if (right < n) expected.push_back(right++);  // Right side
+            }
+        }
+
+        vector<int> result;  // Stores iterator results
+        for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it) {
+            result.push_back(*it);  // Adds element to result
+        }
+        CHECK(result == expected);  // Verifies closed-form order
+    }
+}
+
+// Tests the closed-form side-cross mapping
+// This test case compares the side-cross iterator against alternating picks
+// from both ends of the sorted values for every size from 0 to 40.
+TEST_CASE("Side cross order matches alternating ends for all sizes") {  // Tests side cross rank mapping
+    for (int n = 0; n <= 40; ++n) {  // Loops over container sizes
+        MyContainer<int> c;  // Creates integer container
+        for (int i = 0; i < n; ++i) {
+            c.addElement((i * 7) % 41);  // Distinct values in scrambled order
+        }
+
+        vector<int> sorted(c.getData().begin(), c.getData().end());  // Copies values
+        std::sort(sorted.begin(), sorted.end());  // Sorts values
+        vector<int> expected;  // Expected side cross order
+        for (int lo = 0, hi = n - 1; lo <= hi; ++lo, --hi) {  // Walks inward from both ends
+            expected.push_back(sorted[lo]);  // Smallest remaining
+            if (lo != hi) expected.push_back(sorted[hi]);  // Largest remaining
+        }
+
+        vector<int> result;  // Stores iterator results
+        for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) {
+            result.push_back(*it);  // Adds element to result
+        }
+        CHECK(result == expected);  // Verifies closed-form order
+    }
+}
+
+// Tests lazy sorting mode
+// This test case verifies that a lazily built permutation produces exactly the
+// same orders as an eager one, sorts only what is read, and completes on demand.
+TEST_CASE("Lazy sort mode yields the same orders as eager sorting") {  // Tests lazy permutation refinement
+    MyContainer<int> eager;  // Container using full sorts
+    MyContainer<int> lazy;  // Container using on-demand sorting
+    lazy.setSortMode(SortMode::Lazy);  // Selects lazy mode
+    CHECK(lazy.getSortMode() == SortMode::Lazy);  // Verifies mode was set
+    for (int i = 0; i < 1000; ++i) {
+        int v = (i * 7919) % 263;  // Scrambled values with duplicates
+        eager.addElement(v);  // Adds to eager container
+        lazy.addElement(v);  // Adds to lazy container
+    }
+
+    SUBCASE("Reading a prefix leaves the rest unsorted") {  // Tests partial reads
+        auto it = lazy.begin_ascending_order();  // Lazy ascending iterator
+        auto ref = eager.begin_ascending_order();  // Eager ascending iterator
+        for (int k = 0; k < 10; ++k, ++it, ++ref) {
+            CHECK(*it == *ref);  // Verifies first elements match
+        }
+        CHECK_FALSE(lazy.getSortedPermutation()->isComplete());  // Verifies only a chunk was sorted
+        CHECK(lazy.getSortedIndices() == eager.getSortedIndices());  // Completing yields the same permutation
+        CHECK(lazy.getSortedPermutation()->isComplete());  // Verifies permutation is now complete
+    }
+
+    SUBCASE("Reads from both ends refine only the outer segments") {  // Tests incremental refinement
+        auto it = lazy.begin_ascending_order();  // Lazy ascending iterator
+        auto ref = eager.begin_ascending_order();  // Eager ascending iterator
+        for (ptrdiff_t k = 0; k < 300; ++k) {
+            CHECK(it[k] == ref[k]);  // Front ranks one at a time
+            CHECK(it[999 - k] == ref[999 - k]);  // Back ranks one at a time
+        }
+        CHECK(it[200] == ref[200]);  // Already final: no further work
+        CHECK_FALSE(lazy.getSortedPermutation()->isComplete());  // Verifies the middle is still unsorted
+        CHECK(lazy.getSortedIndices() == eager.getSortedIndices());  // Completing the split segments yields the same permutation
+    }
+
+    SUBCASE("Full traversals match in every sorted order") {  // Tests full reads
+        vector<int> a, b;  // Stores traversal results
+        for (auto it = lazy.begin_descending_order(); it != lazy.end_descending_order(); ++it) a.push_back(*it);  // Lazy descending
+        for (auto it = eager.begin_descending_order(); it != eager.end_descending_order(); ++it) b.push_back(*it);  // Eager descending
+        CHECK(a == b);  // Verifies descending orders match
+        lazy.addElement(-1);  // Invalidates lazy permutation
+        eager.addElement(-1);  // Keeps containers equal
+        a.clear();  // Clears results
+        b.clear();  // Clears results
+        for (auto it = lazy.begin_side_cross_order(); it != lazy.end_side_cross_order(); ++it) a.push_back(*it);  // Lazy side cross
+        for (auto it = eager.begin_side_cross_order(); it != eager.end_side_cross_order(); ++it) b.push_back(*it);  // Eager side cross
+        CHECK(a == b);  // Verifies side cross orders match
+        a.clear();  // Clears results
+        b.clear();  // Clears results
+        for (auto it = lazy.begin_ascending_order(); it != lazy.end_ascending_order(); ++it) a.push_back(*it);  // Lazy ascending
+        for (auto it = eager.begin_ascending_order(); it != eager.end_ascending_order(); ++it) b.push_back(*it);  // Eager ascending
+        CHECK(a == b);  // Verifies ascending orders match
+    }
+}
+
+// Helper returning the stable ascending permutation of a container's data
+template<typename T>  // Template for generic type T
+vector<size_t> expectedPermutation(const MyContainer<T>& c) {  // Reference permutation by stable sort
+    const vector<T>& data = c.getData();  // Container values
+    vector<size_t> idx(data.size());  // Index vector
+    for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;  // Fills 0, 1, 2, ...
+    std::stable_sort(idx.begin(), idx.end(), [&](size_t a, size_t b) { return data[a] < data[b]; });  // Stable sort
+    return idx;  // Returns reference permutation
+}
+
+// Tests incremental maintenance of the sorted permutation on append
+// This test case verifies that appending elements after the permutation was
+// built merges the new tail into the cached order, yielding exactly the
+// permutation a full stable sort would produce.
+TEST_CASE("Sorted permutation is merged incrementally after appends") {  // Tests append-then-scan maintenance
+    for (SortMode mode : {SortMode::Eager, SortMode::Lazy}) {  // Tests both sort modes
+        MyContainer<int> c;  // Creates integer container
+        c.setSortMode(mode);  // Selects sort mode
+        for (int round = 0; round < 20; ++round) {  // Alternates appends and scans
+            for (int i = 0; i < 37; ++i) {
+                c.addElement((round * 131 + i * 17) % 97);  // Appends values with duplicates
+            }
+            CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies merged permutation
+        }
+
+        auto it = c.begin_ascending_order();  // Iterator over merged permutation
+        c.addElement(-5);  // Appends a new minimum
+        CHECK_THROWS_AS(*it, runtime_error);  // Verifies old iterator detects the append
+        CHECK(*c.begin_ascending_order() == -5);  // Verifies new minimum comes first
+        CHECK(*c.begin_descending_order() == 96);  // Verifies maximum is unchanged
+    }
+}
+
+// Tests incremental maintenance of the sorted permutation on removal
+// This test case verifies that removeElement patches the cached permutation
+// (dropping removed ranks and renumbering survivors) for complete, lazily
+// partial and append-pending caches, always matching a full stable sort.
+TEST_CASE("Sorted permutation is patched after removals") {  // Tests mixed add/remove/scan maintenance
+    for (SortMode mode : {SortMode::Eager, SortMode::Lazy}) {  // Tests both sort modes
+        MyContainer<int> c;  // Creates integer container
+        c.setSortMode(mode);  // Selects sort mode
+        for (int i = 0; i < 600; ++i) {
+            c.addElement((i * 37) % 101);  // Values with duplicates
+        }
+
+        auto first = c.begin_ascending_order();  // Builds the cache (partially in lazy mode)
+        CHECK(*first == 0);  // Reads the minimum
+        c.removeElement(0);  // Removes every 0
+        CHECK_THROWS_AS(*first, runtime_error);  // Verifies old iterator detects the removal
+        CHECK(*c.begin_ascending_order() == 1);  // Verifies next minimum
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies patched permutation
+
+        for (int v = 1; v < 100; v += 7) {  // Mixed workload
+            c.addElement(v + 1000);  // Appends a value (pending tail)
+            c.removeElement(v);  // Removes with a pending tail
+            CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies permutation after each step
+        }
+        CHECK_THROWS_AS(c.removeElement(12345), runtime_error);  // Verifies missing element still throws
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies failed removal changed nothing
+    }
+}
+
+// Tests the radix sort backend for arithmetic element types
+// This test case verifies that large int, char and floating-point containers
+// (which use the radix backend) produce exactly the stable ascending
+// permutation, including negative values and the NaN / signed-zero policy.
+TEST_CASE("Radix sort backend matches stable comparison sort") {  // Tests radix sorted permutations
+    SUBCASE("int with negatives") {  // Tests signed integer keys
+        MyContainer<int> c;  // Creates integer container
+        for (int i = 0; i < 5000; ++i) {
+            c.addElement((i * 7919) % 4001 - 2000);  // Values in [-2000, 2000] with duplicates
+        }
+        c.addElement(std::numeric_limits<int>::min());  // Smallest int
+        c.addElement(std::numeric_limits<int>::max());  // Largest int
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies radix permutation
+    }
+
+    SUBCASE("char") {  // Tests single-byte keys
+        MyContainer<char> c;  // Creates char container
+        for (int i = 0; i < 3000; ++i) {
+            c.addElement(static_cast<char>((i * 31) % 128));  // ASCII range with duplicates
+        }
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies radix permutation
+    }
+
+    SUBCASE("double with NaN and signed zero") {  // Tests IEEE-754 keys
+        MyContainer<double> c;  // Creates double container
+        const double nan = std::numeric_limits<double>::quiet_NaN();  // NaN value
+        const double inf = std::numeric_limits<double>::infinity();  // Infinity value
+        for (int i = 0; i < 4000; ++i) {
+            switch (i % 8) {
+                case 0: c.addElement(nan); break;  // NaN
+                case 1: c.addElement(-0.0); break;  // Negative zero
+                case 2: c.addElement(0.0); break;  // Positive zero
+                case 3: c.addElement(i % 16 == 3 ? inf : -inf); break;  // Infinities
+                default: c.addElement((i % 977) * 0.5 - 200.0); break;  // Finite values
+            }
+        }
+
+        const vector<double>& data = c.getData();  // Container values
+        vector<size_t> expected(data.size());  // Reference permutation
+        for (size_t i = 0; i < expected.size(); ++i) expected[i] = i;  // Fills 0, 1, 2, ...
+        std::stable_sort(expected.begin(), expected.end(), [&](size_t a, size_t b) {  // NaN last, -0.0 == 0.0
+            if (std::isnan(data[b])) return !std::isnan(data[a]);  // Everything before NaN
+            if (std::isnan(data[a])) return false;  // NaN never before a number
+            return data[a] < data[b];  // Regular order
+        });
+        CHECK(c.getSortedIndices() == expected);  // Verifies radix permutation
+
+        MyContainer<double> small;  // Below the radix threshold: comparison backend
+        small.addElement(nan);  // NaN first in insertion order
+        small.addElement(1.0);  // Finite value
+        small.addElement(-inf);  // Negative infinity
+        vector<double> asc;  // Stores traversal results
+        for (auto it = small.begin_ascending_order(); it != small.end_ascending_order(); ++it) asc.push_back(*it);  // Ascending
+        CHECK(asc[0] == -inf);  // Verifies negative infinity first
+        CHECK(asc[1] == 1.0);  // Verifies finite value next
+        CHECK(std::isnan(asc[2]));  // Verifies NaN sorts last with the same policy
+    }
+}
+
+// Tests the counting sort fast path for narrow integer ranges
+// This test case verifies that small-range integer and char containers, which
+// take the counting sort path, still produce the stable ascending permutation,
+// while a wide range falls back to the other backends.
+TEST_CASE("Counting sort fast path for narrow key ranges") {  // Tests counting sorted permutations
+    SUBCASE("Multiples of three") {  // Same shape as largeContainer in Main.cpp
+        MyContainer<int> c;  // Creates integer container
+        for (int i = 10; i >= 1; --i) {
+            c.addElement(i * 3);  // Range 3..30 over 10 elements
+        }
+        vector<size_t> idx(c.size());  // Indices in increasing order
+        for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;  // Fills 0, 1, 2, ...
+        CHECK(countingSortIndices(idx.begin(), idx.end(), c.getData()));  // Verifies the fast path applies
+        CHECK(idx == expectedPermutation(c));  // Verifies counting sort result
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies container permutation
+    }
+
+    SUBCASE("Negative narrow range with duplicates") {  // Tests signed keys
+        MyContainer<long> c;  // Creates long container
+        for (int i = 0; i < 500; ++i) {
+            c.addElement(static_cast<long>((i * 13) % 50) - 1000000L);  // 50 distinct values near -1e6
+        }
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies counting sorted permutation
+    }
+
+    SUBCASE("char") {  // Tests chars
+        MyContainer<char> c;  // Creates char container
+        for (char ch : string("the quick brown fox jumps over the lazy dog")) {
+            c.addElement(ch);  // Adds each character
+        }
+        CHECK(c.getSortedIndices() == expectedPermutation(c));  // Verifies counting sorted permutation
+    }
+
+    SUBCASE("Wide range is rejected") {  // Tests fallback
+        vector<int> data = {0, 1000000, 5};  // Range far larger than n
+        vector<size_t> idx = {0, 1, 2};  // Indices in increasing order
+        CHECK_FALSE(countingSortIndices(idx.begin(), idx.end(), data));  // Verifies fast path declines
+        CHECK(idx == vector<size_t>{0, 1, 2});  // Verifies indices were left untouched
+    }
+}
+
+// Small trivially copyable struct ordered by one field, used to exercise record sorting
+struct Reading {  // Sensor reading with a key and payload
+    int key;  // Field used for ordering
+    int payload;  // Field ignored by operator<
+    bool operator<(const Reading& other) const { return key < other.key; }  // Orders by key only
+};
+
+// Struct without a default constructor, which must use the bare index sort
+struct Labeled {  // Value with a label
+    explicit Labeled(int v) : value(v) {}  // Only constructor
+    int value;  // Field used for ordering
+    bool operator<(const Labeled& other) const { return value < other.value; }  // Orders by value
+};
+
+// Tests (key, index) record sorting for cheap-to-copy element types
+// This test case verifies that record-based sorting yields the stable
+// ascending permutation for a small struct, and that types which cannot be
+// copied into records still sort through indices.
+TEST_CASE("Record sort for cheap-to-copy element types") {  // Tests record sorted permutations
+    CHECK(UseRecordSort<Reading>::value);  // Small plain struct uses records
+    CHECK(UseRecordSort<double>::value);  // Arithmetic types use records of keys
+    CHECK_FALSE(UseRecordSort<string>::value);  // Strings compare through indices
+    CHECK_FALSE(UseRecordSort<Labeled>::value);  // No default constructor: indices
+
+    MyContainer<Reading> readings;  // Creates struct container
+    for (int i = 0; i < 300; ++i) {
+        readings.addElement(Reading{(i * 17) % 23, i});  // Duplicate keys, distinct payloads
+    }
+    CHECK(readings.getSortedIndices() == expectedPermutation(readings));  // Verifies stable record sort
+    int lastKey = -1, lastPayload = -1;  // Previous element seen
+    for (auto it = readings.begin_ascending_order(); it != readings.end_ascending_order(); ++it) {
+        Reading r = *it;  // Current element
+        CHECK((r.key > lastKey || (r.key == lastKey && r.payload > lastPayload)));  // Ties in insertion order
+        lastKey = r.key;  // Remembers key
+        lastPayload = r.payload;  // Remembers payload
+    }
+
+    MyContainer<Labeled> labeled;  // Creates container of non-default-constructible values
+    labeled.addElement(Labeled(3));  // Adds 3
+    labeled.addElement(Labeled(1));  // Adds 1
+    labeled.addElement(Labeled(2));  // Adds 2
+    CHECK(labeled.getSortedIndices() == vector<size_t>{1, 2, 0});  // Verifies index sort
+}
+
+// Tests the parallel index sort
+// This test case forces the parallel merge sort on with a low threshold and
+// several chunk counts, and verifies it produces the same stable permutation
+// as the sequential backends for radix, record and index sorted types.
+TEST_CASE("Parallel sort matches sequential sort") {  // Tests parallel permutation builds
+    ParallelSortConfig saved = parallelSortConfig();  // Remembers global tuning
+    parallelSortConfig().threshold = 64;  // Sorts small inputs in parallel
+    for (size_t threads : {2, 3, 4, 7}) {  // Even and odd chunk counts
+        parallelSortConfig().threads = threads;  // Sets chunk count
+
+        MyContainer<int> ints;  // Radix sorted type
+        MyContainer<string> strings;  // Index sorted type
+        MyContainer<Reading> readings;  // Record sorted type
+        for (int i = 0; i < 5000; ++i) {
+            ints.addElement((i * 7919) % 100003 - 50000);  // Wide range, no counting sort
+            strings.addElement(to_string((i * 31) % 977));  // Duplicate strings
+            readings.addElement(Reading{(i * 17) % 501, i});  // Duplicate keys
+        }
+        CHECK(ints.getSortedIndices() == expectedPermutation(ints));  // Verifies int permutation
+        CHECK(strings.getSortedIndices() == expectedPermutation(strings));  // Verifies string permutation
+        CHECK(readings.getSortedIndices() == expectedPermutation(readings));  // Verifies struct permutation
+    }
+    parallelSortConfig() = saved;  // Restores global tuning
+}
+
+// Recursive fork/join sum used by the scheduler test
+long long forkJoinSum(TaskScheduler& scheduler, size_t lo, size_t hi) {  // Sums lo..hi-1
+    if (hi - lo <= 16) {
+        long long total = 0;  // Leaf result
+        for (size_t i = lo; i < hi; ++i) {
+            total += static_cast<long long>(i);
+        }
+        return total;
+    }
+    size_t mid = lo + (hi - lo) / 2;  // Split point
+    long long left = 0;  // Forked half
+    TaskGroup group(scheduler);  // Nested group on the same scheduler
+    group.run([&] { left = forkJoinSum(scheduler, lo, mid); });  // Fork left half
+    long long right = forkJoinSum(scheduler, mid, hi);  // Run right half here
+    group.wait();  // Join (helps with queued tasks)
+    return left + right;
+}
+
+// Tests the work-stealing scheduler
+// This test case checks nested fork/join on a small injected scheduler (which
+// would deadlock if waiting threads blocked), exception propagation from
+// TaskGroup::wait, parallelFor coverage, and the parallel sort running on an
+// injected scheduler.
+TEST_CASE("Work-stealing scheduler fork/join") {  // Tests TaskScheduler and TaskGroup
+    TaskScheduler scheduler(2);  // Fewer workers than nested levels
+    CHECK(scheduler.size() == 2);  // Verifies worker count
+    CHECK(forkJoinSum(scheduler, 0, 10000) == 10000LL * 9999 / 2);  // Verifies nested result
+
+    TaskGroup failing(scheduler);  // Group with a throwing task
+    failing.run([] { throw runtime_error("task failed"); });  // Throws on a worker
+    failing.run([] {});  // Other tasks still complete
+    CHECK_THROWS_AS(failing.wait(), runtime_error);  // Verifies exception reaches the caller
+
+    vector<int> hits(1000, 0);  // One slot per index
+    parallelFor(0, hits.size(), 7, [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            ++hits[i];  // Pieces never overlap
+        }
+    }, scheduler);
+    CHECK(count(hits.begin(), hits.end(), 1) == 1000);  // Verifies every index visited once
+
+    ParallelSortConfig saved = parallelSortConfig();  // Remembers global tuning
+    parallelSortConfig().threshold = 64;  // Sorts small inputs in parallel
+    parallelSortConfig().threads = 4;  // Four chunks
+    parallelSortConfig().scheduler = &scheduler;  // Injected scheduler
+    MyContainer<string> strings;  // Index sorted type
+    for (int i = 0; i < 3000; ++i) {
+        strings.addElement(to_string((i * 31) % 977));  // Duplicate strings
+    }
+    CHECK(strings.getSortedIndices() == expectedPermutation(strings));  // Verifies permutation
+    parallelSortConfig() = saved;  // Restores global tuning
+}
+
+// Tests parallel traversal over every order
+// This test case checks that parallel_transform_reduce with a non-commutative
+// reduction (string concatenation) reproduces the serial iterator order for all
+// six orders, that parallel_for_each visits every element exactly once, and that
+// exceptions from the callback reach the caller.
+TEST_CASE("Parallel traversal matches serial iteration") {  // Tests parallel_for_each and parallel_transform_reduce
+    TaskScheduler scheduler(3);  // Several chunks per order
+    MyContainer<int> c;  // Creates container
+    for (int i = 0; i < 101; ++i) {
+        c.addElement((i * 37) % 50);  // Duplicates and an odd size
+    }
+    auto concat = [](const string& a, const string& b) { return a + b; };  // Associative, not commutative
+    auto show = [](int x) { return to_string(x) + ","; };  // Element to text
+    auto serial = [&](Order order) {  // Serial reference through the iterators
+        string out;
+        switch (order) {
+            case Order::Ascending: for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) out += show(*it); break;
+            case Order::Descending: for (auto it = c.begin_descending_order(); it != c.end_descending_order(); ++it) out += show(*it); break;
+            case Order::SideCross: for (auto it = c.begin_side_cross_order(); it != c.end_side_cross_order(); ++it) out += show(*it); break;
+            case Order::Reverse: for (auto it = c.begin_reverse_order(); it != c.end_reverse_order(); ++it) out += show(*it); break;
+            case Order::Insertion: for (auto it = c.begin_order(); it != c.end_order(); ++it) out += show(*it); break;
+            case Order::MiddleOut: for (auto it = c.begin_middle_out_order(); it != c.end_middle_out_order(); ++it) out += show(*it); break;
+        }
+        return out;
+    };
+    for (Order order : {Order::Ascending, Order::Descending, Order::SideCross,
+                        Order::Reverse, Order::Insertion, Order::MiddleOut}) {
+        CHECK(c.parallel_transform_reduce(order, string(), concat, show, scheduler) == serial(order));  // Same sequence
+        atomic<long long> sum(0);  // Sum of visited elements
+        atomic<int> visits(0);  // Number of visits
+        c.parallel_for_each(order, [&](const int& x) { sum += x; ++visits; }, scheduler);
+        CHECK(visits.load() == 101);  // Every element once
+        CHECK(sum.load() == c.parallel_transform_reduce(order, 0LL, plus<long long>(), [](int x) { return static_cast<long long>(x); }));  // Same total on the global scheduler
+    }
+
+    MyContainer<int> empty;  // Empty container
+    CHECK(empty.parallel_transform_reduce(Order::Ascending, 7, plus<int>(), [](int x) { return x; }) == 7);  // Returns init
+    CHECK_THROWS_AS(c.parallel_for_each(Order::MiddleOut, [](const int& x) {
+        if (x == 49) throw out_of_range("callback failed");  // Fails on one element
+    }, scheduler), out_of_range);  // Verifies exception reaches the caller
+}
+
+// Tests snapshot iteration
+// This test case verifies that in IterationMode::Snapshot every iterator keeps
+// reading the data (and order) it was created on while the container is
+// appended to and removed from, that the pinned snapshot is released with the
+// last iterator, that checked mode still throws, and that container copies
+// share data copy-on-write without affecting each other.
+TEST_CASE("Snapshot iterators survive modification") {  // Tests IterationMode::Snapshot
+    MyContainer<int> c;  // Creates container
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);  // Adds values
+    }
+    c.setIterationMode(IterationMode::Snapshot);  // Opt in
+    CHECK(c.getIterationMode() == IterationMode::Snapshot);  // Verifies mode
+
+    auto asc = c.begin_ascending_order();  // Pinned before the writes
+    auto desc = c.begin_descending_order();
+    auto side = c.begin_side_cross_order();
+    auto rev = c.begin_reverse_order();
+    auto ord = c.begin_order();
+    auto mid = c.begin_middle_out_order();
+    weak_ptr<const vector<int>> pinned = c.pinData();  // Observes the snapshot's lifetime
+
+    c.addElement(0);  // Writers copy instead of touching the snapshot
+    c.addElement(9);
+    c.removeElement(15);
+    CHECK(c.getData() == vector<int>{7, 6, 1, 2, 0, 9});  // Container sees its writes
+
+    auto drain = [](auto it, auto end) {  // Reads until the (live) end iterator
+        vector<int> out;
+        for (; it != end; ++it) {
+            out.push_back(*it);  // Never throws in snapshot mode
+        }
+        return out;
+    };
+    CHECK(drain(asc, c.end_ascending_order()) == vector<int>{1, 2, 6, 7, 15});  // Old ascending order
+    CHECK(drain(desc, c.end_descending_order()) == vector<int>{15, 7, 6, 2, 1});  // Old descending order
+    CHECK(drain(side, c.end_side_cross_order()) == vector<int>{1, 15, 2, 7, 6});  // Old side-cross order
+    CHECK(drain(rev, c.end_reverse_order()) == vector<int>{2, 1, 6, 15, 7});  // Old reverse order
+    CHECK(drain(ord, c.end_order()) == vector<int>{7, 15, 6, 1, 2});  // Old insertion order
+    CHECK(drain(mid, c.end_middle_out_order()) == vector<int>{6, 15, 1, 7, 2});  // Old middle-out order
+    CHECK(drain(c.begin_ascending_order(), c.end_ascending_order()) == vector<int>{0, 1, 2, 6, 7, 9});  // New iterators see new data
+
+    CHECK_FALSE(pinned.expired());  // Still held by the iterators
+    asc = c.end_ascending_order();  // Drop every iterator on the old snapshot
+    desc = c.end_descending_order();
+    side = c.end_side_cross_order();
+    rev = c.end_reverse_order();
+    ord = c.end_order();
+    mid = c.end_middle_out_order();
+    CHECK(pinned.expired());  // Memory reclaimed with the last reader
+
+    c.setIterationMode(IterationMode::Checked);  // Back to the default
+    auto checked = c.begin_order();
+    c.addElement(4);
+    CHECK_THROWS_AS(*checked, runtime_error);  // Checked mode still detects the write
+
+    MyContainer<int> copy = c;  // Shares data until a write
+    copy.addElement(100);  // Copies on write
+    CHECK(c.size() == 7);  // Original unchanged
+    CHECK(copy.size() == 8);  // Copy has the new element
+    c.removeElement(4);  // Original writes its own vector
+    CHECK(copy.getData()[6] == 4);  // Copy unaffected
+}
+
+// Tests snapshot iteration after the container shrinks
+// This test case verifies that a snapshot iterator compared against an end
+// iterator built after removals still visits every pinned element, and that
+// the distance between them is the rest of the snapshot, not of the live data.
+TEST_CASE("Snapshot iterators survive removal") {  // Tests IterationMode::Snapshot with a net shrink
+    MyContainer<int> c;  // Creates container
+    for (int v : {5, 1, 4, 2, 3}) {
+        c.addElement(v);  // Adds values
+    }
+    c.setIterationMode(IterationMode::Snapshot);  // Opt in
+
+    auto ord = c.begin_order();  // Pinned before the write
+    auto asc = c.begin_ascending_order();
+    c.removeElement(4);  // Live data now has 4 elements
+    CHECK(c.end_order() - ord == 5);  // Whole snapshot remains
+    CHECK(ord - c.end_order() == -5);
+    CHECK(c.end_ascending_order() - asc == 5);
+
+    vector<int> seen;
+    for (auto it = ord; it != c.end_order(); ++it) {
+        seen.push_back(*it);  // Reads the snapshot up to its own end
+    }
+    CHECK(seen == vector<int>{5, 1, 4, 2, 3});  // Old insertion order
+    seen.clear();
+    for (auto it = asc; it != c.end_ascending_order(); ++it) {
+        seen.push_back(*it);
+    }
+    CHECK(seen == vector<int>{1, 2, 3, 4, 5});  // Old ascending order
+
+    auto mid = ord + 4;  // Not at the end of the snapshot
+    CHECK(mid != c.end_order());  // Same index as the live end, different data
+    CHECK(c.end_order() - mid == 1);
+    CHECK(ord + 5 == c.end_order());  // Snapshot end matches the live end
+    CHECK(c.begin_order() - c.begin_order() == 0);  // Live iterators still compare by position
+}
+
+// Tests lazy refinement of a shared permutation
+// This test case copies a lazy container after its permutation was built, so
+// both copies (and a snapshot iterator) share one partially sorted permutation,
+// then refines it from several threads at once. Every thread must see the
+// same orders as an eager container. Build with -fsanitize=thread to check
+// for data races.
+TEST_CASE("Lazy permutation shared across threads") {  // Tests concurrent refinement
+    MyContainer<int> a;  // Lazy container
+    MyContainer<int> eager;  // Reference orders
+    a.setSortMode(SortMode::Lazy);
+    for (int i = 0; i < 5000; ++i) {
+        a.addElement((i * 7919) % 1009);  // Scrambled values with duplicates
+        eager.addElement((i * 7919) % 1009);
+    }
+    a.begin_ascending_order();  // Builds the (still unsorted) lazy permutation
+    MyContainer<int> b = a;  // Shares data and permutation
+    a.setIterationMode(IterationMode::Snapshot);
+    auto pinned = a.begin_side_cross_order();  // Snapshot iterator on the same permutation
+    CHECK(a.getSortedPermutation() == b.getSortedPermutation());  // Verifies one shared permutation
+    CHECK_FALSE(b.getSortedPermutation()->isComplete());
+
+    vector<int> asc, desc, side, expectedAsc, expectedDesc, expectedSide;  // Results per thread
+    thread t1([&] { for (int x : a.ascending()) asc.push_back(x); });
+    thread t2([&] { for (int x : b.descending()) desc.push_back(x); });
+    thread t3([&] { for (auto it = pinned; it != a.end_side_cross_order(); ++it) side.push_back(*it); });
+    t1.join();
+    t2.join();
+    t3.join();
+    for (int x : eager.ascending()) expectedAsc.push_back(x);
+    for (int x : eager.descending()) expectedDesc.push_back(x);
+    for (int x : eager.side_cross()) expectedSide.push_back(x);
+    CHECK(asc == expectedAsc);  // Verifies every thread saw a consistent order
+    CHECK(desc == expectedDesc);
+    CHECK(side == expectedSide);
+    CHECK(b.getSortedPermutation()->isComplete());  // Verifies the shared permutation was completed once
+}
+
+// Tests concurrent const reads of one container
+// This test case appends to a container (so its permutation cache is stale) and
+// then reads ascending and descending order from several threads at once; the
+// first readers rebuild the cache concurrently and every thread must see the
+// same orders. Build with -fsanitize=thread to check for data races.
+TEST_CASE("Concurrent readers of one container") {  // Tests the permutation cache under concurrent const calls
+    MyContainer<int> c;  // Creates container
+    for (int i = 0; i < 2000; ++i) {
+        c.addElement((i * 7919) % 1009);  // Scrambled values with duplicates
+    }
+    c.begin_ascending_order();  // Builds the cache
+    c.addElement(-1);  // Stale cache: the next readers merge the tail
+    const MyContainer<int>& reader = c;  // Only const calls from here on
+
+    vector<vector<int>> seen(4);  // Result per thread
+    vector<size_t> copied(4);  // Size of each thread's copy
+    vector<thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            if (t % 2 == 0) {
+                for (int x : reader.ascending()) seen[t].push_back(x);
+            } else {
+                for (int x : reader.descending()) seen[t].push_back(x);
+            }
+            MyContainer<int> copy = reader;  // Copies while other threads fill the cache
+            copied[t] = copy.size();
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    vector<int> expected = c.getData();
+    sort(expected.begin(), expected.end());
+    CHECK(seen[0] == expected);  // Verifies every thread saw a complete order
+    CHECK(seen[2] == expected);
+    reverse(expected.begin(), expected.end());
+    CHECK(seen[1] == expected);
+    CHECK(seen[3] == expected);
+    CHECK(copied == vector<size_t>(4, c.size()));
+}
+
+// Tests the thread-safe container
+// This test case runs one writer appending and removing while several readers
+// build ascending, side-cross and insertion iterators; every reader scan must be
+// internally consistent (sorted, complete snapshot) even though writes continue
+// during the scan. It also checks the single-threaded API and snapshot().
+TEST_CASE("ConcurrentMyContainer readers and writers") {  // Tests ConcurrentMyContainer
+    ConcurrentMyContainer<int> c;  // Creates container
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);  // Adds values
+    }
+    vector<int> asc;  // Ascending scan
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        asc.push_back(*it);
+    }
+    CHECK(asc == vector<int>{1, 2, 6, 7, 15});  // Same order as MyContainer
+    MyContainer<int> copy = c.snapshot();  // Plain container view
+    c.removeElement(15);  // Writer continues
+    CHECK(copy.size() == 5);  // Snapshot unaffected
+    CHECK(c.size() == 4);  // Container updated
+    CHECK(c.getVersion() == 6);  // Five adds and one removal
+    CHECK_THROWS_AS(c.removeElement(100), runtime_error);  // Same errors as MyContainer
+
+    atomic<bool> done(false);  // Stops the readers
+    atomic<int> badScans(0);  // Scans that saw an inconsistent view
+    atomic<int> scans(0);  // Completed scans
+    vector<thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto asc = c.ascending();  // Both ends on one pinned snapshot
+                size_t expected = asc.end() - asc.begin();  // That snapshot's size
+                int last = numeric_limits<int>::min();  // Previous ascending value
+                size_t count = 0;  // Elements seen
+                for (auto it = asc.begin(); it != c.end_ascending_order(); ++it, ++count) {  // Live end, built after writes
+                    if (*it < last) {
+                        ++badScans;  // Order broken mid-scan
+                    }
+                    last = *it;
+                }
+                auto side = c.side_cross();
+                size_t sideCount = 0;  // Side-cross elements seen
+                for (int value : side) {
+                    static_cast<void>(value);  // Reads every element
+                    ++sideCount;
+                }
+                auto order = c.order();
+                size_t orderCount = 0;  // Insertion-order elements seen
+                for (auto it = order.begin(); it != c.end_order(); ++it) {
+                    ++orderCount;
+                }
+                if (expected < 4 || count != expected || sideCount != static_cast<size_t>(side.end() - side.begin())
+                    || orderCount != static_cast<size_t>(order.end() - order.begin())) {
+                    ++badScans;  // Every scan visits exactly its pinned snapshot
+                }
+                ++scans;
+            }
+        });
+    }
+    for (int i = 0; i < 2000; ++i) {
+        c.addElement(1000 + (i * 7919) % 2000);  // Writer appends distinct values
+        if (i % 3 == 0) {
+            c.removeElement(1000 + (i * 7919) % 2000);  // And sometimes removes it again
+        }
+    }
+    while (scans.load() < 10) {
+        this_thread::yield();  // Let every reader finish a few scans on a large container
+    }
+    done = true;
+    for (thread& t : readers) {
+        t.join();
+    }
+    CHECK(badScans.load() == 0);  // Every scan was consistent
+    CHECK(c.size() == 4 + 2000 - 667);  // All writes applied
+    vector<int> finalAsc;  // Final ascending scan
+    for (auto it = c.begin_ascending_order(); it != c.end_ascending_order(); ++it) {
+        finalAsc.push_back(*it);
+    }
+    CHECK(is_sorted(finalAsc.begin(), finalAsc.end()));  // Final order sorted
+    CHECK(finalAsc.size() == c.size());  // And complete
+}
+
+// Tests buffered multi-producer appends
+// This test case has several threads append through addElementBuffered and
+// checks that nothing is visible before a flush, that flush() and begin_*()
+// publish every element, and that each producer's elements keep their order.
+TEST_CASE("ConcurrentMyContainer buffered appends") {  // Tests addElementBuffered and flush
+    ConcurrentMyContainer<int> c;  // Creates container
+    c.addElement(-1);  // Published immediately
+    c.addElementBuffered(-2);  // Buffered on this thread
+    CHECK(c.size() == 1);  // Not visible yet
+    CHECK(c.getVersion() == 1);  // Version unchanged
+    c.flush();  // Publish
+    CHECK(c.size() == 2);  // Now visible
+    CHECK(c.getVersion() == 2);  // One version per element
+
+    vector<thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&c, p] {
+            for (int i = 0; i < 1000; ++i) {
+                c.addElementBuffered(p * 1000 + i);  // Increasing per producer
+            }
+        });
+    }
+    for (thread& t : producers) {
+        t.join();
+    }
+    vector<int> inserted;  // Insertion order; begin_order() flushes first
+    for (auto it = c.begin_order(); it != c.end_order(); ++it) {
+        inserted.push_back(*it);
+    }
+    CHECK(inserted.size() == 4002);  // Every append published
+    vector<int> lastSeen(4, -1);  // Last value per producer
+    for (int v : inserted) {
+        if (v >= 0) {
+            CHECK(v > lastSeen[v / 1000]);  // Producer order kept
+            lastSeen[v / 1000] = v;
+        }
+    }
+    c.addElementBuffered(5000);  // Buffered again
+    c.removeElement(5000);  // Removal publishes buffers first
+    CHECK(c.size() == 4002);  // Added and removed
+}
+
+// Collects one traversal of any container into a vector
+template<typename Iterator>
+vector<int> collect(Iterator begin, Iterator end) {  // Drains begin..end
+    vector<int> out;
+    for (; begin != end; ++begin) {
+        out.push_back(*begin);
+    }
+    return out;
+}
+
+// Tests the sharded container
+// This test case gives a ShardedContainer and a MyContainer the same history
+// of appends (with many duplicates) and removals, and checks that all six
+// merged orders match MyContainer exactly for several shard counts, including
+// tie order between shards. It also checks errors and modification detection.
+TEST_CASE("ShardedContainer matches MyContainer in every order") {  // Tests ShardedContainer
+    for (size_t shardCount : {1, 2, 3, 7}) {
+        ShardedContainer<int> sharded(shardCount);  // Merged views
+        MyContainer<int> reference;  // Expected orders
+        CHECK(sharded.shardCount() == shardCount);  // Verifies shard count
+        for (int i = 0; i < 300; ++i) {
+            int v = (i * 37) % 41;  // Many duplicates spread over shards
+            sharded.addElement(v);
+            reference.addElement(v);
+            if (i % 50 == 49) {
+                sharded.removeElement(v);  // Removes every copy in every shard
+                reference.removeElement(v);
+            }
+        }
+        CHECK(sharded.size() == reference.size());  // Same element count
+        CHECK(collect(sharded.begin_ascending_order(), sharded.end_ascending_order()) ==
+              collect(reference.begin_ascending_order(), reference.end_ascending_order()));
+        CHECK(collect(sharded.begin_descending_order(), sharded.end_descending_order()) ==
+              collect(reference.begin_descending_order(), reference.end_descending_order()));
+        CHECK(collect(sharded.begin_side_cross_order(), sharded.end_side_cross_order()) ==
+              collect(reference.begin_side_cross_order(), reference.end_side_cross_order()));
+        CHECK(collect(sharded.begin_reverse_order(), sharded.end_reverse_order()) ==
+              collect(reference.begin_reverse_order(), reference.end_reverse_order()));
+        CHECK(collect(sharded.begin_order(), sharded.end_order()) ==
+              collect(reference.begin_order(), reference.end_order()));
+        CHECK(collect(sharded.begin_middle_out_order(), sharded.end_middle_out_order()) ==
+              collect(reference.begin_middle_out_order(), reference.end_middle_out_order()));
+        CHECK(captureOutput(reference) == [&] { ostringstream oss; oss << sharded; return oss.str(); }());  // Same printout
+    }
+
+    ShardedContainer<Reading> readings(3);  // Ties compared by key only
+    MyContainer<Reading> expected;
+    for (int i = 0; i < 60; ++i) {
+        readings.addElement(Reading{i % 4, i});  // Equal keys land in different shards
+        expected.addElement(Reading{i % 4, i});
+    }
+    vector<int> shardedPayloads, expectedPayloads;  // Payloads reveal tie order
+    for (auto it = readings.begin_descending_order(); it != readings.end_descending_order(); ++it) {
+        shardedPayloads.push_back((*it).payload);
+    }
+    for (auto it = expected.begin_descending_order(); it != expected.end_descending_order(); ++it) {
+        expectedPayloads.push_back((*it).payload);
+    }
+    CHECK(shardedPayloads == expectedPayloads);  // Equal elements in the same (insertion) order
+
+    ShardedContainer<int> small(2);  // Errors and invalidation
+    small.addElement(1);
+    small.addElement(2);
+    CHECK_THROWS_AS(small.removeElement(3), runtime_error);  // Missing element
+    auto it = small.begin_ascending_order();
+    small.addElement(0);
+    CHECK_THROWS_AS(*it, runtime_error);  // Modified during iteration
+    auto end = small.end_order();
+    CHECK_THROWS_AS(++end, out_of_range);  // Beyond end
+    ShardedContainer<int> empty(4);  // Empty container
+    CHECK(empty.begin_side_cross_order() == empty.end_side_cross_order());  // Nothing to visit
+}
+
+// Tests the iterator check policy
+// This test case verifies that with ARIEL_UNCHECKED_ITERATORS the iterator
+// operators of MyContainer and ShardedContainer are noexcept, and that without
+// it they may throw and the version and bounds checks still fire. It runs in
+// both builds: make test and make test-unchecked.
+TEST_CASE("Iterator check policy") {  // Tests ARIEL_UNCHECKED_ITERATORS
+    MyContainer<int> c;  // Creates container
+    c.addElement(3);  // Adds a value
+    auto it = c.begin_order();
+    auto side = c.begin_side_cross_order();
+    ShardedContainer<int> sharded(2);  // Merged iterators follow the same policy
+    sharded.addElement(3);
+    auto merged = sharded.begin_ascending_order();
+#ifdef ARIEL_UNCHECKED_ITERATORS
+    CHECK(noexcept(++it));  // Unchecked operators cannot throw
+    CHECK(noexcept(*it));
+    CHECK(noexcept(it.operator->()));
+    CHECK(noexcept(side++));
+    CHECK(noexcept(++merged));
+    CHECK(noexcept(merged++));
+    CHECK(noexcept(*merged));
+    CHECK(noexcept(merged.operator->()));
+#else
+    CHECK_FALSE(noexcept(++it));  // Checked operators report misuse by throwing
+    CHECK_FALSE(noexcept(side++));
+    CHECK_FALSE(noexcept(++merged));
+    CHECK_FALSE(noexcept(merged++));
+    c.addElement(4);  // Invalidates it
+    CHECK_THROWS_AS(*it, runtime_error);  // Version check is active
+    auto end = c.end_order();
+    CHECK_THROWS_AS(++end, out_of_range);  // Bounds check is active
+#endif
+}
+
+TEST_CASE("Dereference returns a reference to the stored element") {  // Tests const T& operator* and operator->
+    MyContainer<string> c;  // Creates container
+    for (const char* s : {"pear", "fig", "banana", "kiwi"}) {
+        c.addElement(s);  // Adds values
+    }
+    const vector<string>& data = c.getData();
+    auto ord = c.begin_order();
+    CHECK(&*ord == &data[0]);  // No copy: the element itself
+    CHECK(ord->size() == 4);  // Member access through operator->
+    auto asc = c.begin_ascending_order();
+    CHECK(&*asc == &data[2]);  // "banana" is smallest
+    CHECK(asc->front() == 'b');
+    CHECK(&*c.begin_descending_order() == &data[0]);  // "pear" is largest
+    CHECK(&*c.begin_side_cross_order() == &data[2]);  // Smallest first
+    CHECK(&*c.begin_reverse_order() == &data[3]);  // Newest first
+    CHECK(&*c.begin_middle_out_order() == &data[2]);  // Middle element (right of center)
+
+    c.setIterationMode(IterationMode::Snapshot);  // Snapshot references stay valid across writes
+    auto pinned = c.begin_order();
+    const string& first = *pinned;
+    c.addElement("apple");  // Copies the data; the snapshot keeps the old vector
+    CHECK(first == "pear");
+    CHECK(pinned->size() == 4);
+
+    ShardedContainer<string> sharded(2);  // Sharded iterators return references too
+    sharded.addElement("b");
+    sharded.addElement("a");
+    CHECK(&*sharded.begin_ascending_order() == &sharded.getShard(1).getData()[0]);  // "a" lives in shard 1
+    CHECK(sharded.begin_order()->size() == 1);
+}
+
+TEST_CASE("Random-access iterators") {  // Tests iterator_traits, jumps and differences
+    MyContainer<int> c;  // Creates container
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);  // Adds values
+    }
+    typedef AscendingOrderIterator<int> Asc;
+    CHECK((is_same<iterator_traits<Asc>::iterator_category, random_access_iterator_tag>::value));  // Category
+    CHECK((is_same<iterator_traits<MiddleOutOrderIterator<int>>::value_type, int>::value));
+    CHECK((is_same<iterator_traits<ShardedOrderIterator<int>>::iterator_category, forward_iterator_tag>::value));
+
+    auto asc = c.begin_ascending_order();
+    auto ascEnd = c.end_ascending_order();
+    CHECK(ascEnd - asc == 5);  // O(1) distance
+    CHECK(distance(asc, ascEnd) == 5);
+    CHECK(asc[3] == 7);  // Subscript
+    CHECK(*(asc + 4) == 15);
+    CHECK(*(2 + asc) == 6);
+    CHECK(*lower_bound(asc, ascEnd, 6) == 6);  // Binary search over the sorted order
+    CHECK(binary_search(asc, ascEnd, 15));
+    CHECK_FALSE(binary_search(asc, ascEnd, 3));
+    CHECK(asc < ascEnd);  // Ordering
+    CHECK(ascEnd >= asc);
+
+    auto side = c.begin_side_cross_order();
+    advance(side, 3);  // Jump
+    CHECK(*side == 7);  // 1, 15, 2, 7, 6
+    --side;
+    CHECK(*side == 2);
+    side -= 2;
+    CHECK(*side == 1);
+    CHECK_THROWS_AS(--side, out_of_range);  // Before begin
+    CHECK_THROWS_AS(side += 6, out_of_range);  // Past end
+    CHECK_THROWS_AS(side -= 1, out_of_range);
+
+    vector<int> backwards(make_reverse_iterator(c.end_middle_out_order()), make_reverse_iterator(c.begin_middle_out_order()));
+    CHECK(backwards == vector<int>{2, 7, 1, 15, 6});  // Middle-out 6, 15, 1, 7, 2 walked backwards
+    CHECK(vector<int>(c.begin_descending_order() + 1, c.end_descending_order() - 1) == vector<int>{7, 6, 2});
+    CHECK(c.end_reverse_order() - c.begin_reverse_order() == 5);
+    CHECK(c.begin_order()[4] == 2);
+
+    auto stale = c.begin_order();
+    c.addElement(3);  // Invalidates checked iterators
+    CHECK_THROWS_AS(stale += 1, runtime_error);
+    CHECK_THROWS_AS(stale[0], runtime_error);
+}
+
+TEST_CASE("Range views over every order") {  // Tests ascending(), descending(), ...
+    MyContainer<int> c;  // Creates container
+    for (int v : {7, 15, 6, 1, 2}) {
+        c.addElement(v);  // Adds values
+    }
+    auto drain = [](const auto& view) {  // Range-for over a view
+        vector<int> out;
+        for (const auto& x : view) {
+            out.push_back(x);
+        }
+        return out;
+    };
+    CHECK(drain(c.ascending()) == vector<int>{1, 2, 6, 7, 15});  // Same orders as begin_*/end_*
+    CHECK(drain(c.descending()) == vector<int>{15, 7, 6, 2, 1});
+    CHECK(drain(c.side_cross()) == vector<int>{1, 15, 2, 7, 6});
+    CHECK(drain(c.reverse()) == vector<int>{2, 1, 6, 15, 7});
+    CHECK(drain(c.order()) == vector<int>{7, 15, 6, 1, 2});
+    CHECK(drain(c.middle_out()) == vector<int>{6, 15, 1, 7, 2});
+
+    auto asc = c.ascending();
+    CHECK(asc.size() == 5);  // O(1) for random-access iterators
+    CHECK_FALSE(asc.empty());
+    CHECK(asc[2] == 6);
+    CHECK(*max_element(asc.begin(), asc.end()) == 15);  // Views feed STL algorithms
+    auto copy = asc;  // Cheap copy, shares the permutation
+    CHECK(&*copy.begin() == &*asc.begin());
+    CHECK(drain(copy) == drain(asc));  // Re-iterable
+    CHECK(MyContainer<int>().middle_out().empty());  // Empty container
+
+    ConcurrentMyContainer<int> concurrent;  // Views over the thread-safe container
+    ShardedContainer<int> sharded(3);       // ... and the sharded one
+    for (int v : {7, 15, 6, 1, 2}) {
+        concurrent.addElement(v);
+        sharded.addElement(v);
+    }
+    CHECK(drain(concurrent.side_cross()) == drain(c.side_cross()));
+    CHECK(drain(sharded.middle_out()) == drain(c.middle_out()));
+    CHECK(sharded.descending().size() == 5);
+}
+
+struct EvenPositionsFirst {  // Test policy: even data indices, then odd ones
+    static const bool sorted = false;  // Maps straight to data indices
+
+    static size_t map(size_t position, size_t n) {
+        size_t evens = (n + 1) / 2;  // Number of even indices
+        return position < evens ? 2 * position : 2 * (position - evens) + 1;
+    }
+};
+
+TEST_CASE("Order policies share one iterator template") {  // Tests OrderedIterator
+    CHECK((is_same<AscendingOrderIterator<int>, OrderedIterator<int, AscendingOrder>>::value));  // Old names are aliases
+    CHECK((is_same<DescendingOrderIterator<int>, OrderedIterator<int, DescendingOrder>>::value));
+    CHECK((is_same<SideCrossOrderIterator<int>, OrderedIterator<int, SideCrossOrder>>::value));
+    CHECK((is_same<ReverseOrderIterator<int>, OrderedIterator<int, ReverseOrder>>::value));
+    CHECK((is_same<OrderIterator<int>, OrderedIterator<int, InsertionOrder>>::value));
+    CHECK((is_same<MiddleOutOrderIterator<int>, OrderedIterator<int, MiddleOutOrder>>::value));
+
+    MyContainer<int> c;  // Creates container
+    for (int v : {10, 11, 12, 13, 14}) {
+        c.addElement(v);  // Adds values
+    }
+    typedef OrderedIterator<int, EvenPositionsFirst> Interleaved;  // A new order is just a policy
+    vector<int> out(Interleaved(c), Interleaved(c, true));
+    CHECK(out == vector<int>{10, 12, 14, 11, 13});
+    CHECK(Interleaved(c)[3] == 11);  // Gets random access for free
+    c.addElement(15);
+    CHECK(vector<int>(Interleaved(c), Interleaved(c, true)) == vector<int>{10, 12, 14, 11, 13, 15});
+}
+
+struct EvenRanksFirst {  // Test policy: closed form over the ascending permutation
+    static const bool sorted = true;  // Maps to ranks
+
+    static size_t map(size_t position, size_t n) {
+        return EvenPositionsFirst::map(position, n);  // Even ranks, then odd ranks
+    }
+};
+
+struct ByDistanceFrom10 {  // Test policy: generated permutation, counts its runs
+    static int runs;  // Number of generate() calls
+
+    static vector<size_t> generate(const vector<int>& data) {
+        ++runs;
+        vector<size_t> order(data.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        stable_sort(order.begin(), order.end(), [&data](size_t a, size_t b) {
+            return abs(data[a] - 10) < abs(data[b] - 10);  // Projection: distance from 10
+        });
+        return order;
+    }
+};
+
+int ByDistanceFrom10::runs = 0;
+
+struct BrokenGenerator {  // Test policy: returns too few indices
+    static vector<size_t> generate(const vector<int>&) {
+        return vector<size_t>();
+    }
+};
+
+TEST_CASE("User-defined order policies") {  // Tests begin_custom_order and the generated-permutation cache
+    MyContainer<int> c;  // Creates container
+    for (int v : {4, 12, 9, 20, 10, 1, 7}) {
+        c.addElement(v);  // Adds values
+    }
+    auto collectView = [](const auto& view) { return vector<int>(view.begin(), view.end()); };
+    CHECK(collectView(c.custom_order<EvenRanksFirst>()) == vector<int>{1, 7, 10, 20, 4, 9, 12});  // Ranks 0, 2, 4, 6, then 1, 3, 5
+
+    ByDistanceFrom10::runs = 0;
+    CHECK(collectView(c.custom_order<ByDistanceFrom10>()) == vector<int>{10, 9, 12, 7, 4, 1, 20});
+    auto it = c.begin_custom_order<ByDistanceFrom10>();
+    CHECK(it[2] == 12);  // Random access into the generated order
+    CHECK(c.end_custom_order<ByDistanceFrom10>() - it == 7);
+    CHECK(ByDistanceFrom10::runs == 1);  // Generated once for this version
+    CHECK(c.getGeneratedPermutation<ByDistanceFrom10>() == c.getGeneratedPermutation<ByDistanceFrom10>());  // Shared
+
+    c.addElement(11);  // New version
+    CHECK_THROWS_AS(*it, runtime_error);  // Old iterators are invalidated as usual
+    CHECK(*c.begin_custom_order<ByDistanceFrom10>() == 10);
+    CHECK(c.custom_order<ByDistanceFrom10>()[1] == 9);  // Ties keep insertion order: 9 before 11
+    CHECK(ByDistanceFrom10::runs == 2);  // Regenerated once after the modification
+
+    MyContainer<int> copy = c;  // Copies share the cached permutation
+    CHECK(copy.getGeneratedPermutation<ByDistanceFrom10>() == c.getGeneratedPermutation<ByDistanceFrom10>());
+    CHECK(ByDistanceFrom10::runs == 2);
+
+    CHECK_THROWS_AS(c.begin_custom_order<BrokenGenerator>(), length_error);  // Must cover every element
+    CHECK(c.end_custom_order<BrokenGenerator>() - c.end_custom_order<BrokenGenerator>() == 0);  // End iterators never generate
+
+    c.addElement(8);  // Stale cache, read by several threads at once
+    const MyContainer<int>& reader = c;
+    vector<vector<int>> seen(4);  // Result per thread
+    vector<thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            seen[t] = collectView(reader.custom_order<ByDistanceFrom10>());  // Inserts into the cache map concurrently
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    CHECK(ByDistanceFrom10::runs == 3);  // Generated once for the new version
+    for (const vector<int>& order : seen) {
+        CHECK(order == vector<int>{10, 9, 11, 12, 8, 7, 4, 1, 20});
+    }
+}
+
+struct Point {  // Struct-valued element for projection tests
+    int x;
+    string name;
+
+    bool operator==(const Point& other) const {  // Needed by removeElement
+        return x == other.x && name == other.name;
+    }
+
+    bool operator<(const Point& other) const {  // Default order: by x, then name
+        return x < other.x || (x == other.x && name < other.name);
+    }
+};
+
+struct CountedLength {  // Stateless projection that counts its calls
+    static int calls;
+
+    size_t operator()(const Point& p) const {
+        ++calls;
+        return p.name.size();
+    }
+};
+
+int CountedLength::calls = 0;
+
+TEST_CASE("Comparator and projection orders") {  // Tests begin_ascending_order(comp, proj)
+    MyContainer<Point> c;  // Creates container
+    c.addElement(Point{3, "ccc"});
+    c.addElement(Point{1, "a"});
+    c.addElement(Point{2, "bbbb"});
+    c.addElement(Point{5, "dd"});
+    c.addElement(Point{4, "e"});
+    auto names = [](const auto& view) {  // Names in view order
+        string out;
+        for (const auto& p : view) {
+            out += p.name + " ";
+        }
+        return out;
+    };
+    CHECK(names(c.ascending()) == "a bbbb ccc e dd ");  // Built-in order uses operator<
+    CHECK(names(c.ascending(less<>(), &Point::name)) == "a bbbb ccc dd e ");  // Member-pointer projection
+    CHECK(names(c.descending(less<>(), &Point::x)) == "dd e ccc bbbb a ");
+    CHECK(names(c.side_cross(greater<>(), &Point::x)) == "dd a e bbbb ccc ");  // Largest x, smallest x, ...
+
+    CountedLength::calls = 0;
+    CHECK(names(c.ascending(less<>(), CountedLength())) == "a e dd ccc bbbb ");  // Ties keep insertion order
+    CHECK(CountedLength::calls == 5);  // Projected once per element, not per comparison
+    auto it = c.begin_ascending_order(less<>(), CountedLength());
+    CHECK(it->name == "a");
+    CHECK(CountedLength::calls == 5);  // Stateless: reused for this version
+    CHECK(names(c.descending(less<>(), CountedLength())) == "bbbb ccc dd a e ");  // Ties still by insertion order
+    CHECK(CountedLength::calls == 5);
+
+    int pivot = 3;  // Capturing lambdas have state, so they are never cached
+    auto distance = [pivot](const Point& p) { return abs(p.x - pivot); };
+    CHECK(names(c.ascending(less<>(), distance)) == "ccc bbbb e a dd ");
+    auto first = c.begin_ascending_order(less<>(), distance);
+    CHECK(first != c.end_ascending_order(less<>(), distance));
+    CHECK(c.end_ascending_order(less<>(), distance) - first == 5);
+
+    c.addElement(Point{0, "zzzzzz"});  // New version
+    CHECK_THROWS_AS(*it, runtime_error);  // Old iterators are invalidated as usual
+    CHECK(c.begin_descending_order(less<>(), CountedLength())->name == "zzzzzz");
+    CHECK(CountedLength::calls == 11);  // Re-projected once after the modification
+
+    c.addElement(Point{6, "ff"});  // Stale cache, read by several threads at once
+    const MyContainer<Point>& reader = c;
+    vector<string> seen(4);  // Result per thread
+    vector<thread> threads;
+    for (size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&, t] {
+            seen[t] = names(reader.ascending(less<>(), CountedLength()));  // Inserts into the cache map concurrently
+        });
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+    CHECK(CountedLength::calls == 18);  // Projected once per element, by one thread
+    CHECK(seen == vector<string>(4, "a e dd ff ccc bbbb zzzzzz "));
+}
+
+// Tests tie order in descending traversal
+// This test case verifies that equal elements keep their insertion order in
+// descending order, as they do in ascending order: through full and partial
+// lazy reads, random access, parallel traversal and projected orders.
+TEST_CASE("Descending order keeps equal elements in insertion order") {  // Tests stable descending order
+    MyContainer<Reading> eager;  // Container using full sorts
+    MyContainer<Reading> lazy;  // Container using on-demand sorting
+    lazy.setSortMode(SortMode::Lazy);  // Selects lazy mode
+    vector<int> expected;  // Payloads in descending key order, insertion order within a key
+    for (int i = 0; i < 5000; ++i) {
+        eager.addElement(Reading{(i * 7) % 50, i});  // Runs of 100 equal keys
+        lazy.addElement(Reading{(i * 7) % 50, i});
+    }
+    for (int key = 49; key >= 0; --key) {
+        for (int i = 0; i < 5000; ++i) {
+            if ((i * 7) % 50 == key) expected.push_back(i);
+        }
+    }
+    auto payloads = [](const auto& view) {  // Payloads in view order
+        vector<int> out;
+        for (const auto& r : view) out.push_back(r.payload);
+        return out;
+    };
+    CHECK(payloads(eager.descending()) == expected);  // Eager permutation
+
+    auto top = lazy.begin_descending_order();  // Lazy: only the top runs are sorted
+    for (size_t k : {0, 1, 99, 100, 150}) {
+        CHECK(top[static_cast<ptrdiff_t>(k)].payload == expected[k]);  // Random access inside and across runs
+    }
+    CHECK_FALSE(lazy.getSortedPermutation()->isComplete());  // Verifies the rest is still unsorted
+    CHECK(payloads(lazy.descending()) == expected);  // Full lazy traversal
+
+    auto concat = [](vector<int> a, const vector<int>& b) { a.insert(a.end(), b.begin(), b.end()); return a; };
+    CHECK(eager.parallel_transform_reduce(Order::Descending, vector<int>(), concat,
+                                          [](const Reading& r) { return vector<int>{r.payload}; }) == expected);  // Parallel traversal
+
+    MyContainer<Reading> ties;  // Projected order with equal keys
+    ties.addElement(Reading{1, 10});
+    ties.addElement(Reading{2, 20});
+    ties.addElement(Reading{1, 30});
+    ties.addElement(Reading{2, 40});
+    CHECK(payloads(ties.descending(less<>(), &Reading::key)) == vector<int>{20, 40, 10, 30});  // Projected ties
+    CHECK(payloads(ties.descending()) == vector<int>{20, 40, 10, 30});  // Same as the default order
+    CHECK(payloads(ties.ascending()) == vector<int>{10, 30, 20, 40});  // Ascending ties, for comparison
+}